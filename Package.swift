@@ -53,6 +53,7 @@ let package = Package(
             dependencies: ["SwiftFasterWhisper"],
             resources: [
                 .copy("jfk.wav"),
+                .copy("jfk.flac"),
                 .copy("05-speech.wav"),
                 .copy("06-speech.wav"),
                 .copy("12-speech.wav"),
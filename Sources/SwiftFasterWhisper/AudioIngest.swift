@@ -0,0 +1,41 @@
+//
+// AudioIngest.swift
+// SwiftFasterWhisper
+//
+// Created by Amr Aboelela on 10/18/2026.
+//
+
+import Foundation
+import faster_whisper
+
+/// Writes audio straight into the C++ streaming ring buffer
+///
+/// ## Thread Safety
+/// The ring is single-producer/single-consumer: one writer (the capture side) may call `write()`
+/// while `ModelManager` decodes on its own actor. Only one `AudioIngest` should write per stream.
+public final class AudioIngest: @unchecked Sendable {
+    private let handle: WhisperModelHandle
+
+    init(handle: WhisperModelHandle) {
+        self.handle = handle
+    }
+
+    /// Copy samples into the C++ ring (no allocation, no actor hop)
+    /// - Parameters:
+    ///   - samples: Audio samples (16kHz mono float32)
+    ///   - energyThreshold: Chunks with lower mean absolute amplitude are dropped (0 disables)
+    /// - Returns: Write status and the chunk energy
+    public func write(_ samples: UnsafeBufferPointer<Float>, energyThreshold: Float = 0) -> (status: WhisperWriteStatus, energy: Float) {
+        guard let baseAddress = samples.baseAddress, samples.count > 0 else {
+            return (WHISPER_WRITE_DROPPED, 0)
+        }
+        var energy: Float = 0
+        let status = whisper_write_audio(handle, baseAddress, UInt(samples.count), energyThreshold, &energy)
+        return (status, energy)
+    }
+
+    /// Whether a full window is waiting to be decoded
+    public var isWindowDue: Bool {
+        return whisper_is_window_ready(handle)
+    }
+}
@@ -34,20 +34,22 @@ actor EnergyStatistics {
         return _averageEnergy * Float(thresholdFraction)
     }
 
-    func updateMetrics(energy: Float, chunkDuration: Double, transcriptionTime: Double, wasDropped: Bool) {
-        // Update timing metrics
+    /// Fold the chunks written since the last decode into the statistics in one hop
+    /// - Parameters:
+    ///   - acceptedEnergySum: Sum of the energies of the accepted chunks
+    ///   - acceptedChunkCount: Number of accepted chunks
+    ///   - chunksDuration: Duration of all chunks (accepted and dropped), in seconds
+    ///   - transcriptionTime: Time spent decoding, in seconds
+    /// - Returns: Updated energy threshold
+    func updateMetrics(acceptedEnergySum: Float, acceptedChunkCount: Int, chunksDuration: Double, transcriptionTime: Double) -> Float {
         totalTranscriptionTime += transcriptionTime
-        totalChunksDuration += chunkDuration
-
-        // Update energy average only if chunk was accepted
-        if !wasDropped {
-            if energyChunkCount == 0 {
-                _averageEnergy = energy
-            } else {
-                _averageEnergy = (_averageEnergy * Float(energyChunkCount) + energy) / Float(energyChunkCount + 1)
-            }
-            energyChunkCount += 1
+        totalChunksDuration += chunksDuration
+
+        if acceptedChunkCount > 0 {
+            _averageEnergy = (_averageEnergy * Float(energyChunkCount) + acceptedEnergySum) / Float(energyChunkCount + acceptedChunkCount)
+            energyChunkCount += acceptedChunkCount
         }
+        return getCurrentThreshold()
     }
 
     func reset() {
@@ -0,0 +1,135 @@
+//
+// FeatureStream.swift
+// SwiftFasterWhisper
+//
+// Created by Amr Aboelela on 10/18/2026.
+//
+
+import Foundation
+import faster_whisper
+
+/// How feature values are stored in packets
+public enum FeatureEncoding: Sendable {
+    /// 1 byte per value with a per-packet offset and scale (1/8 of the size of 16-bit PCM)
+    case int8
+    /// 2 bytes per value, for servers that need features closest to the device's
+    case float16
+}
+
+/// Device side of split streaming: extracts log-mel features from audio windows and encodes them as
+/// compact packets to send to a server instead of PCM
+///
+/// ## Thread Safety
+/// Not thread-safe; use one encoder per stream from one thread.
+public final class FeatureStreamEncoder {
+    private let handle: WhisperFeatureEncoderHandle
+
+    /// - Parameters:
+    ///   - encoding: How values are stored
+    ///   - melCount: Mel bins of the server's model (80, or 128 for large-v3)
+    public init?(encoding: FeatureEncoding = .int8, melCount: Int = 80) {
+        let cEncoding = encoding == .float16 ? WHISPER_FEATURES_FP16 : WHISPER_FEATURES_INT8
+        guard let handle = whisper_feature_encoder_create(cEncoding, UInt32(melCount)) else {
+            return nil
+        }
+        self.handle = handle
+    }
+
+    deinit {
+        whisper_feature_encoder_destroy(handle)
+    }
+
+    /// Encode one window of audio
+    /// - Parameter window: Audio samples (16kHz mono float32)
+    /// - Returns: The window's packets, back to back (empty on failure)
+    public func encode(window: [Float]) -> Data {
+        let packets = window.withUnsafeBufferPointer { buffer in
+            whisper_feature_encode_window(handle, buffer.baseAddress, UInt(buffer.count))
+        }
+        defer { whisper_free_byte_array(packets) }
+        guard let data = packets.data, packets.length > 0 else {
+            return Data()
+        }
+        return Data(bytes: data, count: Int(packets.length))
+    }
+
+    /// Decode the first complete window in packet bytes (e.g. to check what a server will receive)
+    /// - Parameter packets: Bytes returned by `encode(window:)`
+    /// - Returns: Features [mel][frame] and the number of windows skipped for missing packets, or nil if no window is complete
+    public static func decode(_ packets: Data) -> (features: [[Float]], droppedWindows: Int)? {
+        var dropped: UInt = 0
+        let matrix = packets.withUnsafeBytes { bytes in
+            whisper_feature_decode(bytes.bindMemory(to: UInt8.self).baseAddress, UInt(packets.count), &dropped)
+        }
+        defer { whisper_free_float_matrix(matrix) }
+        guard let rows = matrix.data, matrix.rows > 0 else {
+            return nil
+        }
+        let features = (0..<Int(matrix.rows)).map { row in
+            Array(UnsafeBufferPointer(start: rows[row], count: Int(matrix.cols)))
+        }
+        return (features, Int(dropped))
+    }
+
+    /// Log-mel features (80 bins) computed on this device, as the encoder sees them before quantization
+    /// - Parameter window: Audio samples (16kHz mono float32)
+    public static func melFeatures(of window: [Float]) -> [[Float]] {
+        let matrix = window.withUnsafeBufferPointer { buffer in
+            whisper_extract_mel_spectrogram(buffer.baseAddress, UInt(buffer.count))
+        }
+        defer { whisper_free_float_matrix(matrix) }
+        guard let rows = matrix.data else {
+            return []
+        }
+        return (0..<Int(matrix.rows)).map { row in
+            Array(UnsafeBufferPointer(start: rows[row], count: Int(matrix.cols)))
+        }
+    }
+}
+
+/// Server side of split streaming: transcribes the feature packets of one device, keeping the
+/// stream's language and prompt history from window to window
+///
+/// ## Thread Safety
+/// Not thread-safe; push the packets of a session from one thread. Decoding runs on the caller's thread.
+public final class FeatureStreamSession {
+    private let handle: WhisperFeatureSessionHandle
+    private let owner: SwiftFasterWhisper  // Keeps the model alive
+
+    init(handle: WhisperFeatureSessionHandle, owner: SwiftFasterWhisper) {
+        self.handle = handle
+        self.owner = owner
+    }
+
+    deinit {
+        whisper_feature_session_destroy(handle)
+    }
+
+    /// Feed received packet bytes (whole packets); every window they complete is transcribed
+    /// - Parameter packets: Bytes produced by `FeatureStreamEncoder`
+    /// - Returns: Segments of the completed windows (times are relative to each window)
+    public func push(_ packets: Data) -> [TranscriptionSegment] {
+        var count: UInt = 0
+        let cSegments = packets.withUnsafeBytes { bytes in
+            whisper_feature_session_push(handle, bytes.bindMemory(to: UInt8.self).baseAddress, UInt(packets.count), &count)
+        }
+        guard count > 0, let cSegments = cSegments else {
+            return []
+        }
+        defer { whisper_free_segments(cSegments, count) }
+
+        return (0..<Int(count)).map { i in
+            let seg = cSegments[i]
+            return TranscriptionSegment(
+                text: seg.text != nil ? String(cString: seg.text) : "",
+                start: seg.start,
+                end: seg.end
+            )
+        }
+    }
+
+    /// Number of windows skipped because of lost packets
+    public var droppedWindows: Int {
+        return Int(whisper_feature_session_dropped_windows(handle))
+    }
+}
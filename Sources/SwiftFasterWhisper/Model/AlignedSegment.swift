@@ -0,0 +1,52 @@
+//
+// AlignedSegment.swift
+// SwiftFasterWhisper
+//
+// Created by Amr Aboelela on 10/18/2026.
+//
+
+import Foundation
+
+/// Timestamps of one word from forced alignment
+public struct AlignedWord: Sendable {
+    /// The word, with its leading space
+    public let word: String
+
+    /// Start time in seconds
+    public let start: Float
+
+    /// End time in seconds
+    public let end: Float
+
+    /// Mean probability of the word's tokens
+    public let probability: Float
+
+    public init(word: String, start: Float, end: Float, probability: Float) {
+        self.word = word
+        self.start = start
+        self.end = end
+        self.probability = probability
+    }
+}
+
+/// A known text aligned against audio, with word-level timestamps
+public struct AlignedSegment: Sendable {
+    /// The text that was aligned
+    public let text: String
+
+    /// Start of the first word in seconds
+    public let start: Float
+
+    /// End of the last word in seconds
+    public let end: Float
+
+    /// Words of the text (empty if the text could not be aligned)
+    public let words: [AlignedWord]
+
+    public init(text: String, start: Float, end: Float, words: [AlignedWord]) {
+        self.text = text
+        self.start = start
+        self.end = end
+        self.words = words
+    }
+}
@@ -0,0 +1,38 @@
+//
+// EncoderEmbedding.swift
+// SwiftFasterWhisper
+//
+// Created by Amr Aboelela on 10/18/2026.
+//
+
+import Foundation
+
+/// Whisper encoder output for one transcribed window, for downstream classifiers
+public struct EncoderEmbedding: Sendable {
+    /// Start of the window's time range in seconds
+    public let start: Float
+
+    /// End of the window's time range in seconds
+    public let end: Float
+
+    /// Number of rows in `values` (1 when pooled)
+    public let positions: Int
+
+    /// Width of each row (the encoder's hidden size)
+    public let dimension: Int
+
+    /// Leading rows that cover audio; the remaining rows encode padding
+    public let contentPositions: Int
+
+    /// Row-major positions x dimension values
+    public let values: [Float]
+
+    public init(start: Float, end: Float, positions: Int, dimension: Int, contentPositions: Int, values: [Float]) {
+        self.start = start
+        self.end = end
+        self.positions = positions
+        self.dimension = dimension
+        self.contentPositions = contentPositions
+        self.values = values
+    }
+}
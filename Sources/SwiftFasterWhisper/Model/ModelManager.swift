@@ -28,9 +28,16 @@ public actor ModelManager {
     private let modelPath: String
     private var language: String?
     private var task: String = "transcribe"
+    private var streamingConfiguration = StreamingConfiguration()
     private var isModelLoaded = false
     private var isStreaming = false
 
+    // processChunk metrics accumulated since the last decoded window (folded into EnergyStatistics once per window)
+    private var chunkEnergyThreshold: Float = 0
+    private var acceptedEnergySum: Float = 0
+    private var acceptedChunkCount = 0
+    private var chunksDuration: Double = 0
+
     // MARK: - Initialization
 
     /// Initialize with model path
@@ -85,23 +92,53 @@ public actor ModelManager {
     /// - Parameters:
     ///   - language: Optional language code (nil for auto-detection)
     ///   - task: Task type - "transcribe" (default) or "translate"
-    public func configure(language: String? = nil, task: String = "transcribe") {
+    ///   - streaming: Window geometry used by the next `startStreaming()`
+    public func configure(
+        language: String? = nil,
+        task: String = "transcribe",
+        streaming: StreamingConfiguration = StreamingConfiguration()
+    ) {
         self.language = language
         self.task = task
+        self.streamingConfiguration = streaming
     }
 
     /// Start streaming session (call once before transcribing)
-    /// - Throws: `RecognitionError` if model not loaded
+    /// - Throws: `RecognitionError` if model not loaded or the streaming configuration is invalid
     public func startStreaming() throws {
         guard let handle = modelHandle else {
             throw RecognitionError.modelNotLoaded
         }
         guard !isStreaming else { return }
 
-        whisper_start_streaming(handle, language, task)
+        var config = streamingConfiguration.cConfig
+        guard whisper_start_streaming_with_config(handle, language, task, &config) else {
+            throw RecognitionError.streamingStartFailed("Invalid streaming configuration")
+        }
+        chunkEnergyThreshold = 0
+        acceptedEnergySum = 0
+        acceptedChunkCount = 0
+        chunksDuration = 0
         isStreaming = true
     }
 
+    /// Current window size of the streaming session in seconds (grows with `autoSize`)
+    public func streamingWindowDuration() -> Double {
+        guard let handle = modelHandle, isStreaming else {
+            return 0
+        }
+        return Double(whisper_streaming_window_seconds(handle))
+    }
+
+    /// Length of the window the next `getNewSegments()` decodes, in seconds
+    /// One window normally; the whole backlog (up to `maxWindowDuration`) when decoding has fallen behind
+    public func nextStreamingWindowDuration() -> Double {
+        guard let handle = modelHandle, isStreaming else {
+            return 0
+        }
+        return Double(whisper_streaming_next_window_seconds(handle))
+    }
+
     /// Stop streaming and reset state
     public func stopStreaming() {
         guard let handle = modelHandle else {
@@ -113,6 +150,43 @@ public actor ModelManager {
         isStreaming = false
     }
 
+    /// Snapshot the streaming session so it can continue on another worker with the same model
+    /// Includes the audio not decoded yet, the window geometry, language, task and prompt history
+    /// - Returns: Compact snapshot to hand to `restoreStreaming(from:)`
+    /// - Throws: `RecognitionError` if model not loaded or streaming not started
+    public func streamingSnapshot() throws -> Data {
+        guard let handle = modelHandle else {
+            throw RecognitionError.modelNotLoaded
+        }
+        guard isStreaming else {
+            throw RecognitionError.streamingNotActive
+        }
+
+        let snapshot = whisper_streaming_snapshot(handle)
+        defer { whisper_free_byte_array(snapshot) }
+        guard let data = snapshot.data, snapshot.length > 0 else {
+            throw RecognitionError.recognitionFailed("Failed to snapshot streaming session")
+        }
+        return Data(bytes: data, count: Int(snapshot.length))
+    }
+
+    /// Continue a streaming session from a snapshot taken on another worker (replaces any current session)
+    /// - Parameter snapshot: Bytes returned by `streamingSnapshot()`
+    /// - Throws: `RecognitionError` if model not loaded, or the snapshot is corrupt or does not fit the model
+    public func restoreStreaming(from snapshot: Data) throws {
+        guard let handle = modelHandle else {
+            throw RecognitionError.modelNotLoaded
+        }
+
+        let restored = snapshot.withUnsafeBytes { bytes in
+            whisper_streaming_restore(handle, bytes.bindMemory(to: UInt8.self).baseAddress, UInt(snapshot.count))
+        }
+        guard restored else {
+            throw RecognitionError.streamingStartFailed("Invalid streaming snapshot")
+        }
+        isStreaming = true
+    }
+
     /// Add audio chunk to streaming buffer (incremental feeding)
     /// - Parameter chunk: Audio samples (16kHz mono float32)
     /// - Throws: `RecognitionError` if model not loaded or streaming not started
@@ -167,80 +241,98 @@ public actor ModelManager {
     public func processChunk(_ chunk: [Float]) async -> [String] {
         // Calculate chunk energy and duration (pure computation, safe anywhere)
         let energy = chunk.reduce(0.0) { $0 + abs($1) } / Float(chunk.count)
-        let chunkDuration = Double(chunk.count) / 16000.0
-
-        // Get current threshold from statistics
-        let threshold = await EnergyStatistics.shared.getCurrentThreshold()
-
-        // Check if we should drop this chunk
-        if threshold > 0 && energy < threshold {
-            let average = await EnergyStatistics.shared.averageEnergy
-            let thresholdPercentage = average > 0 ? (threshold / average) * 100.0 : 0.0
-            print("⚠️  Dropped low-energy chunk (energy: \(String(format: "%.6f", energy)), threshold: \(String(format: "%.6f", threshold)) (\(String(format: "%.1f", thresholdPercentage))%), avg: \(String(format: "%.6f", average)))")
-
-            // Update metrics in background
-            Task(priority: .background) {
-                await EnergyStatistics.shared.updateMetrics(
-                    energy: energy,
-                    chunkDuration: chunkDuration,
-                    transcriptionTime: 0.0,
-                    wasDropped: true
-                )
-            }
+        chunksDuration += Double(chunk.count) / Double(streamingConfiguration.sampleRate)
+
+        // Check against the threshold of the last decoded window (no statistics hop per chunk)
+        if chunkEnergyThreshold > 0 && energy < chunkEnergyThreshold {
+            print("⚠️  Dropped low-energy chunk (energy: \(String(format: "%.6f", energy)), threshold: \(String(format: "%.6f", chunkEnergyThreshold)))")
             return []
         }
 
-        // Measure transcription time
-        let startTime = Date()
-
         // ALL C++ calls happen inside the actor (safe)
         guard let handle = modelHandle else {
             print("❌ Model not loaded")
             return []
         }
 
-        do {
-            // Add chunk to C++ (actor-isolated, safe)
-            try chunk.withUnsafeBufferPointer { buffer in
-                whisper_add_audio_chunk(handle, buffer.baseAddress, UInt(chunk.count))
-            }
+        // Add chunk to C++ (actor-isolated, safe)
+        chunk.withUnsafeBufferPointer { buffer in
+            whisper_add_audio_chunk(handle, buffer.baseAddress, UInt(chunk.count))
+        }
+        acceptedEnergySum += energy
+        acceptedChunkCount += 1
+
+        guard whisper_is_window_ready(handle) else {
+            return []
+        }
 
-            // Get segments from C++ (actor-isolated, safe)
-            var count: UInt = 0
-            let cSegments = whisper_get_new_segments(handle, &count)
+        // Decode the window, then fold this window's chunks into the statistics in one hop
+        let startTime = Date()
+        var count: UInt = 0
+        let cSegments = whisper_get_new_segments(handle, &count)
+        let transcriptionTime = Date().timeIntervalSince(startTime)
+        let decoded = texts(from: cSegments, count: count)
+
+        let energySum = acceptedEnergySum
+        let chunkCount = acceptedChunkCount
+        let duration = chunksDuration
+        acceptedEnergySum = 0
+        acceptedChunkCount = 0
+        chunksDuration = 0
+        chunkEnergyThreshold = await EnergyStatistics.shared.updateMetrics(
+            acceptedEnergySum: energySum,
+            acceptedChunkCount: chunkCount,
+            chunksDuration: duration,
+            transcriptionTime: transcriptionTime
+        )
+        return decoded
+    }
 
-            let transcriptionTime = Date().timeIntervalSince(startTime)
+    // MARK: - Ring Buffer Ingestion
 
-            // Update statistics in background
-            Task(priority: .background) {
-                await EnergyStatistics.shared.updateMetrics(
-                    energy: energy,
-                    chunkDuration: chunkDuration,
-                    transcriptionTime: transcriptionTime,
-                    wasDropped: false
-                )
-            }
+    /// Get a writer for the C++ ring buffer of the current streaming session
+    /// Audio written through it is decoded by `decodeReadyWindow()`
+    /// - Returns: Ingest writer, or nil if streaming not started
+    public func audioIngest() -> AudioIngest? {
+        guard let handle = modelHandle, isStreaming else {
+            return nil
+        }
+        return AudioIngest(handle: handle)
+    }
 
-            guard count > 0, let cSegments = cSegments else {
-                return []
-            }
-            defer { whisper_free_segments(cSegments, count) }
-
-            var result: [String] = []
-            for i in 0..<Int(count) {
-                let seg = cSegments[i]
-                if let text = seg.text {
-                    let trimmed = String(cString: text).trimmingCharacters(in: .whitespacesAndNewlines)
-                    if !trimmed.isEmpty {
-                        result.append(trimmed)
-                    }
-                }
-            }
+    /// Decode the next window written through `AudioIngest` (if one is due)
+    /// - Returns: Transcribed text strings and the time spent decoding
+    public func decodeReadyWindow() -> (texts: [String], transcriptionTime: Double) {
+        guard let handle = modelHandle, isStreaming else {
+            return ([], 0)
+        }
 
-            return result
-        } catch {
-            print("❌ Chunk processing error: \(error)")
+        let startTime = Date()
+        var count: UInt = 0
+        let cSegments = whisper_get_new_segments(handle, &count)
+        let transcriptionTime = Date().timeIntervalSince(startTime)
+
+        return (texts(from: cSegments, count: count), transcriptionTime)
+    }
+
+    /// Convert C segments to trimmed, non-empty strings and free them
+    private func texts(from cSegments: UnsafeMutablePointer<faster_whisper.TranscriptionSegment>?, count: UInt) -> [String] {
+        guard count > 0, let cSegments = cSegments else {
             return []
         }
+        defer { whisper_free_segments(cSegments, count) }
+
+        var result: [String] = []
+        for i in 0..<Int(count) {
+            let seg = cSegments[i]
+            if let text = seg.text {
+                let trimmed = String(cString: text).trimmingCharacters(in: .whitespacesAndNewlines)
+                if !trimmed.isEmpty {
+                    result.append(trimmed)
+                }
+            }
+        }
+
+        return result
     }
 }
@@ -0,0 +1,31 @@
+//
+// ProgressiveUpdate.swift
+// SwiftFasterWhisper
+//
+// Created by Amr Aboelela on 10/18/2026.
+//
+
+import Foundation
+
+/// One decoded window of a progressive transcription
+/// Draft updates arrive first; a final update replaces every draft segment between `start` and `end`
+public struct ProgressiveUpdate: Sendable {
+    /// false for the fast draft pass, true for the accurate pass
+    public let isFinal: Bool
+
+    /// Start of the window's time range in seconds
+    public let start: Float
+
+    /// End of the window's time range in seconds
+    public let end: Float
+
+    /// Segments decoded in this window (empty for silence)
+    public let segments: [TranscriptionSegment]
+
+    public init(isFinal: Bool, start: Float, end: Float, segments: [TranscriptionSegment]) {
+        self.isFinal = isFinal
+        self.start = start
+        self.end = end
+        self.segments = segments
+    }
+}
@@ -33,6 +33,9 @@ public enum RecognitionError: Error, CustomStringConvertible {
     /// Failed to start streaming
     case streamingStartFailed(String)
 
+    /// Transcription time budget ran out before the whole audio was decoded
+    case timeBudgetExceeded
+
     public var description: String {
         switch self {
         case .invalidAudioData:
@@ -51,6 +54,8 @@ public enum RecognitionError: Error, CustomStringConvertible {
             return "Streaming is not active"
         case .streamingStartFailed(let message):
             return "Failed to start streaming: \(message)"
+        case .timeBudgetExceeded:
+            return "Transcription time budget exceeded"
         }
     }
 }
@@ -0,0 +1,58 @@
+//
+// StreamingConfiguration.swift
+// SwiftFasterWhisper
+//
+// Created by Amr Aboelela on 10/18/2026.
+//
+
+import Foundation
+import faster_whisper
+
+/// Window geometry of a streaming session
+/// Short windows give low latency (voice commands), long ones more context per decode (dictation)
+public struct StreamingConfiguration: Sendable {
+    /// Rate of the audio that will be written, in Hz (resampled to 16kHz per window)
+    public var sampleRate: Int
+
+    /// Audio decoded per window, in seconds (at least 0.5)
+    public var windowDuration: Double
+
+    /// Audio trimmed after each window, in seconds; the rest of the window overlaps the next one
+    public var hopDuration: Double
+
+    /// Largest catch-up window when decoding falls behind, in seconds (at most 30)
+    public var maxWindowDuration: Double
+
+    /// Grow the window from the measured real-time factor so decoding keeps up
+    public var autoSize: Bool
+
+    /// Overlap with the next window, in seconds
+    public var overlapDuration: Double {
+        windowDuration - hopDuration
+    }
+
+    public init(
+        sampleRate: Int = 16000,
+        windowDuration: Double = 4.2,
+        hopDuration: Double = 4.0,
+        maxWindowDuration: Double = 30,
+        autoSize: Bool = false
+    ) {
+        self.sampleRate = sampleRate
+        self.windowDuration = windowDuration
+        self.hopDuration = hopDuration
+        self.maxWindowDuration = maxWindowDuration
+        self.autoSize = autoSize
+    }
+
+    /// C configuration for `whisper_start_streaming_with_config`
+    var cConfig: WhisperStreamingConfig {
+        WhisperStreamingConfig(
+            sample_rate: UInt32(sampleRate),
+            window_seconds: Float(windowDuration),
+            hop_seconds: Float(hopDuration),
+            max_window_seconds: Float(maxWindowDuration),
+            auto_size: autoSize
+        )
+    }
+}
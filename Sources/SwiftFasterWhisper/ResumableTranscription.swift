@@ -0,0 +1,64 @@
+//
+// ResumableTranscription.swift
+// SwiftFasterWhisper
+//
+// Created by Amr Aboelela on 10/18/2026.
+//
+
+import Foundation
+import faster_whisper
+
+/// A long transcription pulled one segment at a time, which can be checkpointed between segments
+/// and resumed later (or on another worker) on the same audio
+///
+/// ## Thread Safety
+/// Not thread-safe; call `next()` and `checkpoint()` from one thread. `next()` blocks while a window is decoded.
+public final class ResumableTranscription {
+    private let handle: WhisperSegmentIteratorHandle
+    private let owner: SwiftFasterWhisper  // Keeps the model alive
+
+    init(handle: WhisperSegmentIteratorHandle, owner: SwiftFasterWhisper) {
+        self.handle = handle
+        self.owner = owner
+    }
+
+    deinit {
+        whisper_destroy_iterator(handle)
+    }
+
+    /// Get the next segment, decoding windows until one produces text
+    /// - Returns: The segment, or nil once the whole audio is transcribed
+    /// - Throws: `RecognitionError` if decoding fails or the time budget runs out
+    public func next() throws -> TranscriptionSegment? {
+        var segment = faster_whisper.TranscriptionSegment(text: nil, start: 0, end: 0)
+        switch whisper_iterator_next(handle, &segment) {
+        case WHISPER_ITERATOR_SEGMENT:
+            let text = segment.text != nil ? String(cString: segment.text) : ""
+            whisper_free_segment(segment)
+            return TranscriptionSegment(text: text, start: segment.start, end: segment.end)
+        case WHISPER_ITERATOR_FINISHED, WHISPER_ITERATOR_CANCELLED:
+            return nil
+        case WHISPER_ITERATOR_BUDGET_EXCEEDED:
+            throw RecognitionError.timeBudgetExceeded
+        default:
+            throw RecognitionError.recognitionFailed("Segment decoding failed")
+        }
+    }
+
+    /// Seconds of audio decoded so far
+    public var progress: Float {
+        return whisper_iterator_progress(handle)
+    }
+
+    /// Snapshot the transcription: seek position, prompt tail, and the segments returned and still pending
+    /// - Returns: Compact CRC-checked blob for `SwiftFasterWhisper.resumeTranscription(audio:checkpoint:)`
+    /// - Throws: `RecognitionError` if the checkpoint cannot be encoded
+    public func checkpoint() throws -> Data {
+        let bytes = whisper_iterator_checkpoint(handle)
+        defer { whisper_free_byte_array(bytes) }
+        guard let data = bytes.data, bytes.length > 0 else {
+            throw RecognitionError.recognitionFailed("Failed to checkpoint transcription")
+        }
+        return Data(bytes: data, count: Int(bytes.length))
+    }
+}
@@ -8,16 +8,22 @@
 import Foundation
 
 /// Handles streaming audio processing using producer-consumer pattern
-/// Producer: addAudioChunk() quickly adds chunks to queue
-/// Consumer: Background task processes chunks and sends to C++
+/// Producer: addAudioChunk() writes samples straight into the C++ ring buffer
+/// Consumer: Background task wakes only when a full window is due and decodes it
 public actor StreamingRecognizer {
     private let modelManager: ModelManager
     private var pendingText: String = ""
 
     // Producer-consumer pattern
-    private var chunksQueue: [[Float]] = []
-    private var readIndex = 0
+    private var ingest: AudioIngest?
     private var isConsuming = false
+    private var energyThreshold: Float = 0
+
+    // Metrics accumulated since the last decode (folded into EnergyStatistics once per window)
+    private var acceptedEnergySum: Float = 0
+    private var acceptedChunkCount = 0
+    private var chunksDuration: Double = 0
+    private var sampleRate: Double = 16000
 
     /// Initialize with model path
     /// - Parameters:
@@ -30,29 +36,56 @@ public actor StreamingRecognizer {
     /// - Parameters:
     ///   - language: Language code (nil for auto-detection)
     ///   - task: "transcribe" or "translate"
-    public func configure(language: String? = nil, task: String = "transcribe") async throws {
+    ///   - streaming: Window geometry of the session
+    public func configure(
+        language: String? = nil,
+        task: String = "transcribe",
+        streaming: StreamingConfiguration = StreamingConfiguration()
+    ) async throws {
         try await modelManager.loadModel()
-        await modelManager.configure(language: language, task: task)
+        await modelManager.configure(language: language, task: task, streaming: streaming)
+        sampleRate = Double(streaming.sampleRate)
         try await modelManager.startStreaming()
+        ingest = await modelManager.audioIngest()
+        energyThreshold = await EnergyStatistics.shared.getCurrentThreshold()
     }
 
-    /// Add audio chunk to queue (producer - fast, non-blocking)
-    /// Starts consumer task if not already running
+    /// Add audio chunk (producer - fast, non-blocking)
+    /// Starts consumer task if a window is due and it is not already running
     /// - Parameter chunk: Audio samples (16kHz mono float32, typically 30ms chunks work well)
     /// - Returns: New transcribed text since last call
     public func addAudioChunk(_ chunk: [Float]) -> String {
-        // Drop all pending chunks if backlog is too large
-        if chunksQueue.count >= 10 {
-            let dropCount = chunksQueue.count
-            chunksQueue.removeAll()
-            readIndex = 0
-            print("#debug ⚠️  Dropped all \(dropCount) pending chunks, starting fresh")
+        return chunk.withUnsafeBufferPointer { buffer in
+            addAudioChunk(buffer)
+        }
+    }
+
+    /// Add audio samples without creating an array (producer - fast, non-blocking)
+    /// The samples are copied once, directly into the C++ ring buffer
+    /// - Parameter samples: Audio samples (16kHz mono float32)
+    /// - Returns: New transcribed text since last call
+    public func addAudioChunk(_ samples: UnsafeBufferPointer<Float>) -> String {
+        guard let ingest, samples.count > 0 else {
+            return getNewText()
         }
 
-        chunksQueue.append(chunk)
+        let (status, energy) = ingest.write(samples, energyThreshold: energyThreshold)
+        chunksDuration += Double(samples.count) / sampleRate
+
+        switch status {
+        case WHISPER_WRITE_BUFFERED, WHISPER_WRITE_WINDOW_READY:
+            acceptedEnergySum += energy
+            acceptedChunkCount += 1
+        case WHISPER_WRITE_DROPPED:
+            print("⚠️  Dropped low-energy chunk (energy: \(String(format: "%.6f", energy)), threshold: \(String(format: "%.6f", energyThreshold)))")
+        case WHISPER_WRITE_OVERFLOW:
+            print("#debug ⚠️  Ring buffer full, dropped \(samples.count) samples")
+        default:
+            break
+        }
 
         // Start consumer if not already running (set flag first to prevent race)
-        if !isConsuming {
+        if status == WHISPER_WRITE_WINDOW_READY && !isConsuming {
             isConsuming = true
             startConsumer()
         }
@@ -68,30 +101,27 @@ public actor StreamingRecognizer {
         }
     }
 
-    /// Consume chunks in a loop (actor-owned)
+    /// Decode windows while one is due (actor-owned)
     private func consumeLoop() async {
-        while true {
-            guard let chunk = dequeueChunk() else {
-                // Queue exhausted - reset consuming flag and exit
-                isConsuming = false
-                return
-            }
-            let texts = await modelManager.processChunk(chunk)
+        while let ingest, ingest.isWindowDue {
+            let (texts, transcriptionTime) = await modelManager.decodeReadyWindow()
             appendTexts(texts)
-        }
-    }
 
-    /// Dequeue next chunk from queue (O(1) using index)
-    private func dequeueChunk() -> [Float]? {
-        guard readIndex < chunksQueue.count else {
-            // Queue exhausted - reset for next batch
-            chunksQueue.removeAll()
-            readIndex = 0
-            return nil
+            let energySum = acceptedEnergySum
+            let chunkCount = acceptedChunkCount
+            let duration = chunksDuration
+            acceptedEnergySum = 0
+            acceptedChunkCount = 0
+            chunksDuration = 0
+            energyThreshold = await EnergyStatistics.shared.updateMetrics(
+                acceptedEnergySum: energySum,
+                acceptedChunkCount: chunkCount,
+                chunksDuration: duration,
+                transcriptionTime: transcriptionTime
+            )
         }
-        let chunk = chunksQueue[readIndex]
-        readIndex += 1
-        return chunk
+        // No window due - reset consuming flag and exit
+        isConsuming = false
     }
 
     /// Append texts to pending text (actor-isolated, fast)
@@ -116,10 +146,13 @@ public actor StreamingRecognizer {
     /// Stop streaming and cleanup
     public func stop() async {
         // Clear all state
-        chunksQueue.removeAll()
-        readIndex = 0
+        ingest = nil
         isConsuming = false
         pendingText = ""
+        energyThreshold = 0
+        acceptedEnergySum = 0
+        acceptedChunkCount = 0
+        chunksDuration = 0
         await modelManager.stopStreaming()
     }
 
@@ -65,7 +65,7 @@ public final class SwiftFasterWhisper {
 
     /// Translate audio from a file path to English using Whisper's built-in translation
     /// - Parameters:
-    ///   - audioFilePath: Path to audio file (WAV format recommended)
+    ///   - audioFilePath: Path to audio file (WAV or FLAC)
     ///   - sourceLanguage: Optional source language code (nil for auto-detection)
     /// - Returns: Translation result with segments and metadata
     /// - Throws: `RecognitionError` if translation fails
@@ -118,7 +118,7 @@ public final class SwiftFasterWhisper {
 
     /// Transcribe audio from a file path
     /// - Parameters:
-    ///   - audioFilePath: Path to audio file (WAV format recommended)
+    ///   - audioFilePath: Path to audio file (WAV or FLAC)
     ///   - language: Optional language code (nil for auto-detection)
     /// - Returns: Transcription result with segments and metadata
     /// - Throws: `RecognitionError` if transcription fails
@@ -174,17 +174,443 @@ public final class SwiftFasterWhisper {
         return try convertToSwiftResult(result)
     }
 
+    // MARK: - Encoder Embeddings
+
+    /// Transcribe audio and also return the encoder output of every window, so speaker or
+    /// audio-event classifiers can reuse it instead of running their own front ends
+    /// - Parameters:
+    ///   - audio: Audio samples (16kHz float32)
+    ///   - language: Optional language code (nil for auto-detection)
+    ///   - pooled: true for one mean vector per window, false for every encoder position (1500 per window)
+    /// - Returns: The transcription and one embedding per decoded window
+    /// - Throws: `RecognitionError` if transcription fails
+    public func transcribeWithEmbeddings(audio: [Float], language: String? = nil, pooled: Bool = true) async throws -> (result: TranscriptionResult, embeddings: [EncoderEmbedding]) {
+        guard let handle = modelHandle else {
+            throw RecognitionError.modelNotLoaded
+        }
+
+        guard !audio.isEmpty else {
+            throw RecognitionError.invalidAudioData
+        }
+
+        let sink = EmbeddingSink()
+        let result = withExtendedLifetime(sink) {
+            audio.withUnsafeBufferPointer { buffer in
+                whisper_transcribe_with_embeddings(
+                    handle,
+                    buffer.baseAddress,
+                    UInt(audio.count),
+                    language,
+                    pooled ? WHISPER_EMBEDDING_POOLED : WHISPER_EMBEDDING_FRAMES,
+                    { context, start, end, data, positions, dimension, contentPositions in
+                        let sink = Unmanaged<EmbeddingSink>.fromOpaque(context!).takeUnretainedValue()
+                        let values = Array(UnsafeBufferPointer(start: data, count: Int(positions * dimension)))
+                        sink.embeddings.append(EncoderEmbedding(
+                            start: start,
+                            end: end,
+                            positions: Int(positions),
+                            dimension: Int(dimension),
+                            contentPositions: Int(contentPositions),
+                            values: values
+                        ))
+                    },
+                    Unmanaged.passUnretained(sink).toOpaque()
+                )
+            }
+        }
+        defer { whisper_free_transcription_result(result) }
+
+        return (try convertToSwiftResult(result), sink.embeddings)
+    }
+
+    // MARK: - Lazy Transcription
+
+    /// Transcribe a long file segment by segment
+    /// Segments are delivered as each 30s window is decoded, so the first one arrives after about one window
+    /// Cancelling the consuming task (or dropping the stream) stops decoding before the next window
+    /// - Parameters:
+    ///   - audioFilePath: Path to audio file (WAV or FLAC)
+    ///   - language: Optional language code (nil for auto-detection)
+    ///   - timeBudget: Optional wall-clock limit in seconds; the stream throws `RecognitionError.timeBudgetExceeded` when it runs out
+    /// - Returns: Stream of transcription segments in order
+    /// - Throws: `RecognitionError` if the audio cannot be loaded or transcription cannot start
+    public func transcribeSegments(audioFilePath: String, language: String? = nil, timeBudget: TimeInterval? = nil) throws -> AsyncThrowingStream<TranscriptionSegment, Error> {
+        guard let handle = modelHandle else {
+            throw RecognitionError.modelNotLoaded
+        }
+
+        // Load audio (the iterator keeps its own features, so the samples can be freed right away)
+        let audioArray = whisper_load_audio(audioFilePath)
+        guard audioArray.data != nil, audioArray.length > 0 else {
+            throw RecognitionError.invalidAudioData
+        }
+        defer { whisper_free_float_array(audioArray) }
+
+        guard let iterator = whisper_transcribe_iter(
+            handle,
+            audioArray.data,
+            audioArray.length,
+            language,
+            nil,
+            timeBudget ?? 0
+        ) else {
+            throw RecognitionError.recognitionFailed("Failed to start transcription")
+        }
+
+        return segmentStream(SegmentIteratorHandle(iterator))
+    }
+
+    /// Start a long transcription that can be checkpointed between segments (see `ResumableTranscription`)
+    /// - Parameters:
+    ///   - audio: Audio samples (16kHz mono float32)
+    ///   - language: Optional language code (nil for auto-detection)
+    ///   - timeBudget: Optional wall-clock limit in seconds
+    /// - Returns: The transcription; nothing is decoded until `next()` is called
+    /// - Throws: `RecognitionError` if the audio is empty or transcription cannot start
+    public func startResumableTranscription(audio: [Float], language: String? = nil, timeBudget: TimeInterval? = nil) throws -> ResumableTranscription {
+        guard let handle = modelHandle else {
+            throw RecognitionError.modelNotLoaded
+        }
+        guard !audio.isEmpty else {
+            throw RecognitionError.invalidAudioData
+        }
+
+        let iterator = audio.withUnsafeBufferPointer { buffer in
+            whisper_transcribe_iter(handle, buffer.baseAddress, UInt(buffer.count), language, nil, timeBudget ?? 0)
+        }
+        guard let iterator else {
+            throw RecognitionError.recognitionFailed("Failed to start transcription")
+        }
+        return ResumableTranscription(handle: iterator, owner: self)
+    }
+
+    /// Continue a transcription from a checkpoint taken on the same audio
+    /// Segments not returned before the checkpoint come first
+    /// - Parameters:
+    ///   - audio: The same audio samples the checkpoint was taken on
+    ///   - checkpoint: Blob from `ResumableTranscription.checkpoint()`
+    ///   - timeBudget: Optional wall-clock limit in seconds
+    /// - Returns: The resumed transcription
+    /// - Throws: `RecognitionError` if the checkpoint is corrupt or was taken on different audio
+    public func resumeTranscription(audio: [Float], checkpoint: Data, timeBudget: TimeInterval? = nil) throws -> ResumableTranscription {
+        guard let handle = modelHandle else {
+            throw RecognitionError.modelNotLoaded
+        }
+        guard !audio.isEmpty else {
+            throw RecognitionError.invalidAudioData
+        }
+
+        let iterator = audio.withUnsafeBufferPointer { buffer in
+            checkpoint.withUnsafeBytes { bytes in
+                whisper_resume_iter(
+                    handle,
+                    buffer.baseAddress,
+                    UInt(buffer.count),
+                    bytes.bindMemory(to: UInt8.self).baseAddress,
+                    UInt(checkpoint.count),
+                    timeBudget ?? 0
+                )
+            }
+        }
+        guard let iterator else {
+            throw RecognitionError.recognitionFailed("Checkpoint is corrupt or belongs to different audio")
+        }
+        return ResumableTranscription(handle: iterator, owner: self)
+    }
+
+    // MARK: - Progressive Transcription
+
+    /// Transcribe a file in two passes: a fast draft running ahead of the accurate transcript
+    /// Draft windows are delivered within seconds; each window of the final pass replaces the draft segments
+    /// in its time range. With a `draftModel` the passes run concurrently, and draft windows the final pass
+    /// has already covered are not delivered; without one the draft finishes before the final pass starts
+    /// - Parameters:
+    ///   - audioFilePath: Path to audio file (WAV or FLAC)
+    ///   - language: Optional language code (nil for auto-detection)
+    ///   - draftModel: Optional smaller loaded model for the draft pass (nil decodes the draft greedily with this model)
+    /// - Returns: Stream of draft and final updates, finishing after the last final window
+    /// - Throws: `RecognitionError` if the audio cannot be loaded
+    public func transcribeProgressive(audioFilePath: String, language: String? = nil, draftModel: SwiftFasterWhisper? = nil) throws -> AsyncThrowingStream<ProgressiveUpdate, Error> {
+        guard let handle = modelHandle else {
+            throw RecognitionError.modelNotLoaded
+        }
+
+        let audioArray = whisper_load_audio(audioFilePath)
+        guard audioArray.data != nil, audioArray.length > 0 else {
+            throw RecognitionError.invalidAudioData
+        }
+
+        let draftHandle = draftModel?.modelHandle
+
+        return AsyncThrowingStream { continuation in
+            let sink = Unmanaged.passRetained(ProgressiveUpdateSink(continuation)).toOpaque()
+
+            Task.detached(priority: .userInitiated) {
+                // Keep both models alive while the C++ layer uses their handles
+                let result = withExtendedLifetime((self, draftModel)) {
+                    whisper_transcribe_progressive(
+                        handle,
+                        draftHandle,
+                        audioArray.data,
+                        audioArray.length,
+                        language,
+                        { context, isFinal, start, end, segments, count in
+                            let sink = Unmanaged<ProgressiveUpdateSink>.fromOpaque(context!).takeUnretainedValue()
+                            let swiftSegments = (0..<Int(count)).map { i in
+                                let segment = segments![i]
+                                let text = segment.text != nil ? String(cString: segment.text) : ""
+                                return TranscriptionSegment(text: text, start: segment.start, end: segment.end)
+                            }
+                            sink.continuation.yield(ProgressiveUpdate(isFinal: isFinal, start: start, end: end, segments: swiftSegments))
+                        },
+                        sink
+                    )
+                }
+                whisper_free_float_array(audioArray)
+                defer { whisper_free_transcription_result(result) }
+
+                Unmanaged<ProgressiveUpdateSink>.fromOpaque(sink).release()
+
+                if result.language == nil {
+                    continuation.finish(throwing: RecognitionError.recognitionFailed("Progressive transcription failed"))
+                } else {
+                    continuation.finish()
+                }
+            }
+        }
+    }
+
+    // MARK: - Stereo Transcription
+
+    /// Transcribe a stereo file with one speaker per channel (e.g. agent / customer call recordings)
+    /// Both channels are encoded and decoded together as a batch of two
+    /// - Parameters:
+    ///   - audioFilePath: Path to a stereo audio file (WAV or FLAC)
+    ///   - language: Optional language code (nil for auto-detection)
+    /// - Returns: Per-channel transcription results with timestamps on the same timeline
+    /// - Throws: `RecognitionError` if the file is not stereo or transcription fails
+    public func transcribeStereo(audioFilePath: String, language: String? = nil) async throws -> (left: TranscriptionResult, right: TranscriptionResult) {
+        guard modelHandle != nil else {
+            throw RecognitionError.modelNotLoaded
+        }
+
+        var leftArray = FloatArray(data: nil, length: 0)
+        var rightArray = FloatArray(data: nil, length: 0)
+        guard whisper_load_audio_stereo(audioFilePath, &leftArray, &rightArray) else {
+            throw RecognitionError.invalidAudioData
+        }
+        defer {
+            whisper_free_float_array(leftArray)
+            whisper_free_float_array(rightArray)
+        }
+
+        let left = Array(UnsafeBufferPointer(start: leftArray.data, count: Int(leftArray.length)))
+        let right = Array(UnsafeBufferPointer(start: rightArray.data, count: Int(rightArray.length)))
+
+        return try await transcribeStereo(left: left, right: right, language: language)
+    }
+
+    /// Transcribe two channels of the same recording as a batch of two
+    /// - Parameters:
+    ///   - left: Left channel samples (16kHz float32)
+    ///   - right: Right channel samples (16kHz float32, same length as left)
+    ///   - language: Optional language code (nil for auto-detection)
+    /// - Returns: Per-channel transcription results (a silent channel has no segments)
+    /// - Throws: `RecognitionError` if transcription fails
+    public func transcribeStereo(left: [Float], right: [Float], language: String? = nil) async throws -> (left: TranscriptionResult, right: TranscriptionResult) {
+        guard let handle = modelHandle else {
+            throw RecognitionError.modelNotLoaded
+        }
+
+        guard !left.isEmpty, left.count == right.count else {
+            throw RecognitionError.invalidAudioData
+        }
+
+        let result = left.withUnsafeBufferPointer { leftBuffer in
+            right.withUnsafeBufferPointer { rightBuffer in
+                whisper_transcribe_stereo(
+                    handle,
+                    leftBuffer.baseAddress,
+                    rightBuffer.baseAddress,
+                    UInt(left.count),
+                    language
+                )
+            }
+        }
+        defer { whisper_free_stereo_transcription_result(result) }
+
+        guard result.left.language != nil else {
+            throw RecognitionError.recognitionFailed("Stereo transcription failed")
+        }
+
+        return (
+            try convertToSwiftResult(result.left, requireSegments: false),
+            try convertToSwiftResult(result.right, requireSegments: false)
+        )
+    }
+
+    // MARK: - Forced Alignment
+
+    /// Align known texts (e.g. a script or a corrected transcript) against audio without decoding
+    /// Consecutive texts without a time range are aligned together after the previous timed text,
+    /// so long audio needs a time range at least every 30 seconds
+    /// - Parameters:
+    ///   - audio: Audio samples (16kHz float32)
+    ///   - texts: Texts in the order they are spoken
+    ///   - timeRanges: Optional approximate time range of each text in seconds (nil entries are untimed)
+    ///   - language: Optional language code (nil for auto-detection)
+    /// - Returns: One aligned segment per text, with word timestamps
+    /// - Throws: `RecognitionError` if alignment fails
+    public func align(audio: [Float], texts: [String], timeRanges: [(start: Float, end: Float)?]? = nil, language: String? = nil) async throws -> [AlignedSegment] {
+        guard let handle = modelHandle else {
+            throw RecognitionError.modelNotLoaded
+        }
+
+        guard !audio.isEmpty, !texts.isEmpty else {
+            throw RecognitionError.invalidAudioData
+        }
+
+        let cTexts = texts.map { UnsafePointer<CChar>(strdup($0)) }
+        defer { cTexts.forEach { free(UnsafeMutablePointer(mutating: $0)) } }
+
+        let starts = texts.indices.map { timeRanges?[$0]?.start ?? -1 }
+        let ends = texts.indices.map { timeRanges?[$0]?.end ?? -1 }
+
+        let result = audio.withUnsafeBufferPointer { audioBuffer in
+            whisper_align(
+                handle,
+                audioBuffer.baseAddress,
+                UInt(audio.count),
+                cTexts,
+                starts,
+                ends,
+                UInt(texts.count),
+                language
+            )
+        }
+        defer { whisper_free_alignment_result(result) }
+
+        guard result.segments != nil else {
+            throw RecognitionError.recognitionFailed("Alignment failed")
+        }
+
+        return (0..<Int(result.segment_count)).map { i in
+            let segment = result.segments[i]
+            let words = (0..<Int(segment.word_count)).map { j in
+                let word = segment.words[j]
+                return AlignedWord(
+                    word: word.word != nil ? String(cString: word.word) : "",
+                    start: word.start,
+                    end: word.end,
+                    probability: word.probability
+                )
+            }
+            return AlignedSegment(
+                text: segment.text != nil ? String(cString: segment.text) : "",
+                start: segment.start,
+                end: segment.end,
+                words: words
+            )
+        }
+    }
+
+    // MARK: - Throughput
+
+    /// Speed speech up before transcribing files, for bulk jobs where throughput matters more than the last bit of accuracy
+    /// The audio is time-compressed without changing its pitch, so each 30s encoder window covers `factor` times
+    /// as much audio; segment timestamps are still in the original time. Streaming is not affected
+    /// - Parameter factor: Speed-up between 1 (off) and 2, e.g. 1.25
+    /// - Throws: `RecognitionError` if the factor is out of range
+    public func setTimeCompression(_ factor: Float) throws {
+        guard let handle = modelHandle else {
+            throw RecognitionError.modelNotLoaded
+        }
+
+        guard whisper_set_time_compression(handle, factor) else {
+            throw RecognitionError.recognitionFailed("Time compression factor must be between 1 and 2, got \(factor)")
+        }
+    }
+
+    /// Cut off decoding attempts that run away, for noisy audio prone to repetition loops
+    /// An attempt still generating after `tokensPerSecond` tokens per second of window (plus 32 tokens of slack)
+    /// is treated as failed and the next fallback temperature starts right away. Off by default
+    /// - Parameter tokensPerSecond: Budget, e.g. 20 (fast speech is about 12 tokens/s); 0 turns it off
+    /// - Throws: `RecognitionError` if the budget is negative
+    public func setTokenBudget(tokensPerSecond: Float) throws {
+        guard let handle = modelHandle else {
+            throw RecognitionError.modelNotLoaded
+        }
+
+        guard whisper_set_token_budget(handle, tokensPerSecond) else {
+            throw RecognitionError.recognitionFailed("Token budget must not be negative, got \(tokensPerSecond)")
+        }
+    }
+
+    // MARK: - Feature Streaming
+
+    /// Start a server-side session transcribing the feature packets of one device (see `FeatureStreamEncoder`)
+    /// - Parameters:
+    ///   - language: Language code of the stream, nil for auto-detect
+    ///   - task: "transcribe" or "translate"
+    /// - Returns: A session; it keeps this model loaded while alive
+    /// - Throws: `RecognitionError` if the model is not loaded or the session cannot be created
+    public func makeFeatureSession(language: String? = nil, task: String = "transcribe") throws -> FeatureStreamSession {
+        guard let handle = modelHandle else {
+            throw RecognitionError.modelNotLoaded
+        }
+
+        guard let session = whisper_feature_session_create(handle, language, task) else {
+            throw RecognitionError.streamingStartFailed("Failed to create feature session")
+        }
+        return FeatureStreamSession(handle: session, owner: self)
+    }
+
     // MARK: - Helper Methods
 
-    private func convertToSwiftResult(_ cResult: faster_whisper.TranscriptionResult) throws -> TranscriptionResult {
-        guard cResult.segment_count > 0, cResult.segments != nil else {
-            throw RecognitionError.recognitionFailed("No segments returned")
+    private func segmentStream(_ iterator: SegmentIteratorHandle) -> AsyncThrowingStream<TranscriptionSegment, Error> {
+        AsyncThrowingStream { continuation in
+            continuation.onTermination = { _ in
+                iterator.cancel()
+            }
+
+            Task.detached(priority: .userInitiated) {
+                var segment = faster_whisper.TranscriptionSegment(text: nil, start: 0, end: 0)
+                var failure: Error?
+
+                decoding: while true {
+                    switch iterator.next(&segment) {
+                    case WHISPER_ITERATOR_SEGMENT:
+                        let text = segment.text != nil ? String(cString: segment.text) : ""
+                        whisper_free_segment(segment)
+                        continuation.yield(TranscriptionSegment(text: text, start: segment.start, end: segment.end))
+                    case WHISPER_ITERATOR_FINISHED, WHISPER_ITERATOR_CANCELLED:
+                        break decoding
+                    case WHISPER_ITERATOR_BUDGET_EXCEEDED:
+                        failure = RecognitionError.timeBudgetExceeded
+                        break decoding
+                    default:
+                        failure = RecognitionError.recognitionFailed("Segment decoding failed")
+                        break decoding
+                    }
+                }
+
+                iterator.destroy()
+                continuation.finish(throwing: failure)
+            }
+        }
+    }
+
+    private func convertToSwiftResult(_ cResult: faster_whisper.TranscriptionResult, requireSegments: Bool = true) throws -> TranscriptionResult {
+        if requireSegments {
+            guard cResult.segment_count > 0, cResult.segments != nil else {
+                throw RecognitionError.recognitionFailed("No segments returned")
+            }
         }
 
-        let segments = cResult.segments!
+        let segments = cResult.segments
 
         let swiftSegments = (0..<Int(cResult.segment_count)).map { i in
-            let segment = segments[i]
+            let segment = segments![i]
             let text = segment.text != nil ? String(cString: segment.text) : ""
             return TranscriptionSegment(
                 text: text,
@@ -203,6 +629,20 @@ public final class SwiftFasterWhisper {
         )
     }
 
+    /// Decode an audio file the way file transcription does
+    /// - Parameter path: Path to audio file (16-bit PCM WAV or FLAC, any channel count)
+    /// - Returns: Samples at 16kHz, with all channels mixed down to mono
+    /// - Throws: `RecognitionError.invalidAudioData` if the file cannot be decoded
+    public static func loadAudio(path: String) throws -> [Float] {
+        let audioArray = whisper_load_audio(path)
+        guard let data = audioArray.data, audioArray.length > 0 else {
+            throw RecognitionError.invalidAudioData
+        }
+        defer { whisper_free_float_array(audioArray) }
+
+        return Array(UnsafeBufferPointer(start: data, count: Int(audioArray.length)))
+    }
+
     /// Get the path to a bundled model if available
     /// - Returns: Path to bundled model, or nil if not found
     public static func bundledModelPath() -> String? {
@@ -213,3 +653,57 @@ public final class SwiftFasterWhisper {
         #endif
     }
 }
+
+/// Carries the stream continuation through the C callback's context pointer
+/// Collects the embeddings reported during whisper_transcribe_with_embeddings (called on the same thread)
+private final class EmbeddingSink {
+    var embeddings: [EncoderEmbedding] = []
+}
+
+private final class ProgressiveUpdateSink {
+    let continuation: AsyncThrowingStream<ProgressiveUpdate, Error>.Continuation
+
+    init(_ continuation: AsyncThrowingStream<ProgressiveUpdate, Error>.Continuation) {
+        self.continuation = continuation
+    }
+}
+
+/// Owns a C segment iterator so it can be cancelled from the stream's termination handler
+/// while the decoding task is still pulling from it
+private final class SegmentIteratorHandle: @unchecked Sendable {
+    private var handle: WhisperSegmentIteratorHandle?
+    private let lock = NSLock()
+
+    init(_ handle: WhisperSegmentIteratorHandle) {
+        self.handle = handle
+    }
+
+    deinit {
+        destroy()
+    }
+
+    func next(_ segment: inout faster_whisper.TranscriptionSegment) -> WhisperIteratorStatus {
+        // Not under the lock: decoding a window takes seconds and cancel() must get through meanwhile
+        guard let handle else {
+            return WHISPER_ITERATOR_CANCELLED
+        }
+        return whisper_iterator_next(handle, &segment)
+    }
+
+    func cancel() {
+        lock.lock()
+        defer { lock.unlock() }
+        if let handle {
+            whisper_iterator_cancel(handle)
+        }
+    }
+
+    func destroy() {
+        lock.lock()
+        defer { lock.unlock() }
+        if let handle {
+            whisper_destroy_iterator(handle)
+        }
+        handle = nil
+    }
+}
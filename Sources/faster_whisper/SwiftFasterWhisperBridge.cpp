@@ -9,22 +9,75 @@
 #include "whisper/whisper_audio.h"
 #include "feature_extractor.h"
 #include "transcribe.h"
+#include "segment_iterator.h"
+#include "transcription_checkpoint.h"
 #include "streaming_buffer.h"
+#include "shared_audio_ring.h"
+#include "streaming_context.h"
+#include "streaming_snapshot.h"
+#include "feature_stream.h"
+#include <chrono>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <map>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <algorithm>
 #include <sstream>
 #include <set>
 
 // Global map to store streaming buffers for each model
 static std::map<WhisperModelHandle, std::shared_ptr<StreamingBuffer>> streaming_buffers;
-static std::map<WhisperModelHandle, std::string> streaming_language;
-static std::map<WhisperModelHandle, std::string> streaming_task;  // "transcribe" or "translate"
+static std::map<WhisperModelHandle, std::shared_ptr<StreamingContext>> streaming_contexts;  // Language, task and token history
 static std::map<WhisperModelHandle, size_t> last_transcribed_position;  // Track last transcribed window position
+static std::mutex streaming_mutex;  // Guards the maps above (audio is written from the capture thread)
+
+// Look up the streaming buffer for a model (nullptr if streaming not started)
+static std::shared_ptr<StreamingBuffer> find_streaming_buffer(WhisperModelHandle model) {
+    std::lock_guard<std::mutex> lock(streaming_mutex);
+    auto it = streaming_buffers.find(model);
+    return it != streaming_buffers.end() ? it->second : nullptr;
+}
+
+// Look up the streaming context for a model (nullptr if streaming not started or already stopped)
+static std::shared_ptr<StreamingContext> find_streaming_context(WhisperModelHandle model) {
+    std::lock_guard<std::mutex> lock(streaming_mutex);
+    auto it = streaming_contexts.find(model);
+    return it != streaming_contexts.end() ? it->second : nullptr;
+}
+
+// Record that the window at position is being decoded
+// Returns false if it already was, or if the session was stopped meanwhile
+static bool claim_window_position(WhisperModelHandle model, size_t position) {
+    std::lock_guard<std::mutex> lock(streaming_mutex);
+    auto it = last_transcribed_position.find(model);
+    if (it == last_transcribed_position.end() || it->second == position) {
+        return false;
+    }
+    it->second = position;
+    return true;
+}
+
+// Forget the decoded window position after a trim (no-op once the session is stopped)
+static void reset_window_position(WhisperModelHandle model) {
+    std::lock_guard<std::mutex> lock(streaming_mutex);
+    auto it = last_transcribed_position.find(model);
+    if (it != last_transcribed_position.end()) {
+        it->second = SIZE_MAX;
+    }
+}
+
+// Remove all streaming state for a model
+static void erase_streaming_state(WhisperModelHandle model) {
+    std::lock_guard<std::mutex> lock(streaming_mutex);
+    streaming_buffers.erase(model);
+    streaming_contexts.erase(model);
+    last_transcribed_position.erase(model);
+}
 
 // Check if audio buffer is all dummy values (~0.1) used for flushing in tests
 static bool isDummyBuffer(const std::vector<float>& audio) {
@@ -186,6 +239,138 @@ static bool isHallucination(const std::string& text) {
     return false;
 }
 
+// Copy segments and info into a malloc'd C result
+static TranscriptionResult make_transcription_result(
+    const std::vector<Segment>& segments,
+    const TranscriptionInfo& info
+) {
+    TranscriptionResult result = {nullptr, 0, nullptr, 0.0f, 0.0f};
+
+    result.segment_count = segments.size();
+    if (result.segment_count > 0) {
+        result.segments = static_cast<TranscriptionSegment*>(
+            malloc(result.segment_count * sizeof(TranscriptionSegment))
+        );
+
+        for (size_t i = 0; i < segments.size(); ++i) {
+            const auto& seg = segments[i];
+
+            result.segments[i].text = static_cast<char*>(malloc(seg.text.length() + 1));
+            std::strcpy(result.segments[i].text, seg.text.c_str());
+
+            result.segments[i].start = seg.start;
+            result.segments[i].end = seg.end;
+        }
+    }
+
+    result.language = static_cast<char*>(malloc(info.language.length() + 1));
+    std::strcpy(result.language, info.language.c_str());
+
+    result.language_probability = info.language_probability;
+    result.duration = info.duration;
+
+    return result;
+}
+
+// Copy samples into a malloc'd C array
+static FloatArray make_float_array(const std::vector<float>& samples) {
+    FloatArray result = {nullptr, 0};
+    if (samples.empty()) {
+        return result;
+    }
+
+    result.data = static_cast<float*>(malloc(samples.size() * sizeof(float)));
+    if (result.data) {
+        std::memcpy(result.data, samples.data(), samples.size() * sizeof(float));
+        result.length = samples.size();
+    }
+    return result;
+}
+
+// Copy a matrix into malloc'd rows for whisper_free_float_matrix (empty on allocation failure)
+static FloatMatrix make_float_matrix(const Matrix& matrix) {
+    FloatMatrix result = {nullptr, 0, 0};
+    if (matrix.empty()) {
+        return result;
+    }
+
+    // Allocate C 2D array and copy data
+    result.rows = matrix.size();
+    result.cols = matrix[0].size();
+    result.data = static_cast<float**>(malloc(result.rows * sizeof(float*)));
+
+    if (result.data) {
+        for (unsigned long i = 0; i < result.rows; ++i) {
+            result.data[i] = static_cast<float*>(malloc(result.cols * sizeof(float)));
+            if (result.data[i]) {
+                std::memcpy(result.data[i], matrix[i].data(), result.cols * sizeof(float));
+            } else {
+                // Cleanup on failure
+                for (unsigned long j = 0; j < i; ++j) {
+                    free(result.data[j]);
+                }
+                free(result.data);
+                result.data = nullptr;
+                result.rows = 0;
+                result.cols = 0;
+                return result;
+            }
+        }
+    } else {
+        result.rows = 0;
+        result.cols = 0;
+    }
+
+    return result;
+}
+
+// Drop segments whose text is a known hallucination
+static std::vector<Segment> filter_hallucinations(const std::vector<Segment>& segments) {
+    std::vector<Segment> filtered_segments;
+    for (const auto& seg : segments) {
+        std::string trimmed_text = seg.text;
+        // Trim whitespace
+        size_t start = trimmed_text.find_first_not_of(" \t\n\r");
+        size_t end = trimmed_text.find_last_not_of(" \t\n\r");
+        if (start != std::string::npos && end != std::string::npos) {
+            trimmed_text = trimmed_text.substr(start, end - start + 1);
+        }
+
+        // Skip hallucinations
+        if (!isHallucination(trimmed_text)) {
+            filtered_segments.push_back(seg);
+        } else {
+            std::cout << "#debug ⚠️  Filtered hallucination: \"" << trimmed_text << "\"" << std::endl;
+        }
+    }
+    return filtered_segments;
+}
+
+// Copy segments into a malloc'd array for whisper_free_segments (nullptr if there are none)
+static TranscriptionSegment* make_segment_array(const std::vector<Segment>& segments, unsigned long* count) {
+    *count = segments.size();
+    if (*count == 0) {
+        return nullptr;
+    }
+
+    TranscriptionSegment* result = static_cast<TranscriptionSegment*>(
+        malloc(*count * sizeof(TranscriptionSegment))
+    );
+
+    for (size_t i = 0; i < segments.size(); ++i) {
+        const auto& seg = segments[i];
+
+        // Allocate and copy text
+        result[i].text = static_cast<char*>(malloc(seg.text.length() + 1));
+        std::strcpy(result[i].text, seg.text.c_str());
+
+        result[i].start = seg.start;
+        result[i].end = seg.end;
+    }
+
+    return result;
+}
+
 extern "C" {
 
 FloatArray whisper_load_audio(const char* filename) {
@@ -214,6 +399,32 @@ FloatArray whisper_load_audio(const char* filename) {
     return result;
 }
 
+bool whisper_load_audio_stereo(const char* filename, FloatArray* left, FloatArray* right) {
+    if (!filename || !left || !right) {
+        return false;
+    }
+
+    *left = {nullptr, 0};
+    *right = {nullptr, 0};
+
+    auto channels = whisper::AudioProcessor::load_audio_split_stereo(filename);
+    if (channels.first.empty() || channels.second.empty()) {
+        return false;
+    }
+
+    *left = make_float_array(channels.first);
+    *right = make_float_array(channels.second);
+    if (!left->data || !right->data) {
+        whisper_free_float_array(*left);
+        whisper_free_float_array(*right);
+        *left = {nullptr, 0};
+        *right = {nullptr, 0};
+        return false;
+    }
+
+    return true;
+}
+
 FloatMatrix whisper_extract_mel_spectrogram(const float* audio, unsigned long length) {
     FloatMatrix result = {nullptr, 0, 0};
 
@@ -234,34 +445,7 @@ FloatMatrix whisper_extract_mel_spectrogram(const float* audio, unsigned long le
         return result;
     }
 
-    // Allocate C 2D array and copy data
-    result.rows = mel_spec.size();
-    result.cols = mel_spec[0].size();
-    result.data = static_cast<float**>(malloc(result.rows * sizeof(float*)));
-
-    if (result.data) {
-        for (unsigned long i = 0; i < result.rows; ++i) {
-            result.data[i] = static_cast<float*>(malloc(result.cols * sizeof(float)));
-            if (result.data[i]) {
-                std::memcpy(result.data[i], mel_spec[i].data(), result.cols * sizeof(float));
-            } else {
-                // Cleanup on failure
-                for (unsigned long j = 0; j < i; ++j) {
-                    free(result.data[j]);
-                }
-                free(result.data);
-                result.data = nullptr;
-                result.rows = 0;
-                result.cols = 0;
-                return result;
-            }
-        }
-    } else {
-        result.rows = 0;
-        result.cols = 0;
-    }
-
-    return result;
+    return make_float_matrix(mel_spec);
 }
 
 void whisper_free_float_array(FloatArray array) {
@@ -313,15 +497,57 @@ WhisperModelHandle whisper_create_model(const char* model_path) {
 void whisper_destroy_model(WhisperModelHandle model) {
     if (model) {
         // Clean up streaming resources if any
-        streaming_buffers.erase(model);
-        streaming_language.erase(model);
-        streaming_task.erase(model);
-        last_transcribed_position.erase(model);
+        erase_streaming_state(model);
 
         delete static_cast<WhisperModel*>(model);
     }
 }
 
+AllocatorStats whisper_get_allocator_stats(WhisperModelHandle model) {
+    AllocatorStats result = {0, 0, 0, 0, 0};
+
+    if (!model) {
+        return result;
+    }
+
+    auto stats = static_cast<WhisperModel*>(model)->allocator_stats();
+    result.hits = stats.hits;
+    result.misses = stats.misses;
+    result.bytes_reserved = stats.bytes_reserved;
+    result.bytes_in_use = stats.bytes_in_use;
+    result.peak_bytes_in_use = stats.peak_bytes_in_use;
+
+    return result;
+}
+
+bool whisper_set_time_compression(WhisperModelHandle model, float factor) {
+    if (!model) {
+        return false;
+    }
+
+    try {
+        static_cast<WhisperModel*>(model)->set_time_compression(factor);
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Invalid time compression: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool whisper_set_token_budget(WhisperModelHandle model, float tokens_per_second) {
+    if (!model) {
+        return false;
+    }
+
+    try {
+        static_cast<WhisperModel*>(model)->set_token_budget(tokens_per_second);
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Invalid token budget: " << e.what() << std::endl;
+        return false;
+    }
+}
+
 TranscriptionResult whisper_transcribe(
     WhisperModelHandle model,
     const float* audio,
@@ -377,6 +603,45 @@ TranscriptionResult whisper_transcribe(
     return result;
 }
 
+unsigned long whisper_transcribe_files(
+    WhisperModelHandle model,
+    const char* const* paths,
+    unsigned long path_count,
+    const char* language,
+    unsigned long prefetch,
+    WhisperFileCallback callback,
+    void* context
+) {
+    if (!model || !paths || path_count == 0 || !callback) {
+        return 0;
+    }
+
+    try {
+        auto* whisper_model = static_cast<WhisperModel*>(model);
+
+        std::vector<std::string> path_vec;
+        for (unsigned long i = 0; i < path_count; ++i) {
+            path_vec.push_back(paths[i] ? paths[i] : "");
+        }
+        std::optional<std::string> lang = language ? std::optional<std::string>(language) : std::nullopt;
+
+        return whisper_model->transcribe_files(path_vec, [callback, context](const FileTranscription& file) {
+            if (!file.error.empty()) {
+                std::cerr << "Transcription of " << file.path << " failed: " << file.error << std::endl;
+                callback(context, file.index, file.path.c_str(), nullptr);
+                return;
+            }
+            TranscriptionResult result = make_transcription_result(file.segments, file.info);
+            callback(context, file.index, file.path.c_str(), &result);
+            whisper_free_transcription_result(result);
+        }, lang, true, "transcribe", prefetch > 0 ? prefetch : 2);
+
+    } catch (const std::exception& e) {
+        std::cerr << "Batch transcription failed: " << e.what() << std::endl;
+        return 0;
+    }
+}
+
 TranscriptionResult whisper_translate(
     WhisperModelHandle model,
     const float* audio,
@@ -433,116 +698,637 @@ TranscriptionResult whisper_translate(
     return result;
 }
 
-// Streaming functions
-
-void whisper_start_streaming(
+StereoTranscriptionResult whisper_transcribe_stereo(
     WhisperModelHandle model,
-    const char* language,
-    const char* task
+    const float* left,
+    const float* right,
+    unsigned long audio_length,
+    const char* language
 ) {
-    if (!model) {
-        return;
-    }
-
-    // Create streaming buffer with 4-second sliding window (4s shifts)
-    streaming_buffers[model] = std::make_shared<StreamingBuffer>(16000);
-    streaming_language[model] = language ? std::string(language) : "";
-    streaming_task[model] = task ? std::string(task) : "transcribe";
-    last_transcribed_position[model] = SIZE_MAX;  // Initialize to invalid position
-}
+    StereoTranscriptionResult result = {
+        {nullptr, 0, nullptr, 0.0f, 0.0f},
+        {nullptr, 0, nullptr, 0.0f, 0.0f}
+    };
 
-void whisper_add_audio_chunk(
-    WhisperModelHandle model,
-    const float* chunk,
-    unsigned long chunk_length
-) {
-    if (!model || !chunk || chunk_length == 0) {
-        return;
+    if (!model || !left || !right || audio_length == 0) {
+        return result;
     }
 
-    auto it = streaming_buffers.find(model);
-    if (it == streaming_buffers.end()) {
-        std::cerr << "Streaming not started for this model" << std::endl;
-        return;
-    }
+    try {
+        auto* whisper_model = static_cast<WhisperModel*>(model);
 
-    std::vector<float> chunk_vec(chunk, chunk + chunk_length);
-    it->second->add_chunk(chunk_vec);
-}
+        std::vector<float> left_vec(left, left + audio_length);
+        std::vector<float> right_vec(right, right + audio_length);
 
-bool whisper_is_window_ready(WhisperModelHandle model) {
-    if (!model) {
-        return false;
-    }
+        std::optional<std::string> lang = language ? std::optional<std::string>(language) : std::nullopt;
+        auto [channels, info] = whisper_model->transcribe_stereo(left_vec, right_vec, lang, true);
 
-    auto buffer_it = streaming_buffers.find(model);
-    if (buffer_it == streaming_buffers.end()) {
-        return false;
+        result.left = make_transcription_result(channels[0], info);
+        result.right = make_transcription_result(channels[1], info);
+
+    } catch (const std::exception& e) {
+        std::cerr << "Stereo transcription failed: " << e.what() << std::endl;
     }
 
-    return buffer_it->second->is_ready_to_decode();
+    return result;
 }
 
-void whisper_trim_buffer(
+TranscriptionResult whisper_transcribe_with_embeddings(
     WhisperModelHandle model,
-    unsigned long sample_count
+    const float* audio,
+    unsigned long audio_length,
+    const char* language,
+    WhisperEmbeddingMode mode,
+    WhisperEmbeddingCallback callback,
+    void* context
 ) {
-    if (!model || sample_count == 0) {
-        return;
-    }
+    TranscriptionResult result = {nullptr, 0, nullptr, 0.0f, 0.0f};
 
-    auto buffer_it = streaming_buffers.find(model);
-    if (buffer_it == streaming_buffers.end()) {
-        std::cerr << "Streaming not started for this model" << std::endl;
-        return;
+    if (!model || !audio || audio_length == 0 || !callback) {
+        return result;
     }
 
-    auto buffer = buffer_it->second;
-    if (buffer->size() >= sample_count) {
-        buffer->trim_samples(sample_count);
-        // Reset transcribed position since we trimmed
-        last_transcribed_position[model] = SIZE_MAX;
+    // Handed to this call only, so concurrent transcriptions on the model do not see it
+    auto on_encoder_output = [mode, callback, context](const EncoderWindow& window) {
+        if (mode == WHISPER_EMBEDDING_POOLED) {
+            std::vector<float> pooled = WhisperModel::pool_encoder_output(window);
+            callback(context, window.start, window.end, pooled.data(), 1, pooled.size(), 1);
+            return;
+        }
+
+        const ctranslate2::StorageView* output = window.output;
+        ctranslate2::StorageView converted;
+        if (output->device() != ctranslate2::Device::CPU || output->dtype() != ctranslate2::DataType::FLOAT32) {
+            converted = output->to(ctranslate2::Device::CPU).to_float32();
+            output = &converted;
+        }
+        const size_t positions = static_cast<size_t>(output->dim(1));
+        const size_t dim = static_cast<size_t>(output->dim(2));
+        callback(context, window.start, window.end,
+                 output->data<float>() + window.batch_index * positions * dim,
+                 positions, dim, std::min(window.content_positions, positions));
+    };
+
+    try {
+        auto* whisper_model = static_cast<WhisperModel*>(model);
+        std::vector<float> audio_vec(audio, audio + audio_length);
+        std::optional<std::string> lang = language ? std::optional<std::string>(language) : std::nullopt;
+        auto [segments, info] = whisper_model->transcribe(audio_vec, lang, true, "transcribe", on_encoder_output);
+        result = make_transcription_result(segments, info);
+
+    } catch (const std::exception& e) {
+        std::cerr << "Transcription with embeddings failed: " << e.what() << std::endl;
     }
+
+    return result;
 }
 
-TranscriptionSegment* whisper_get_new_segments(
+TranscriptionResult whisper_transcribe_progressive(
     WhisperModelHandle model,
-    unsigned long* count
+    WhisperModelHandle draft_model,
+    const float* audio,
+    unsigned long audio_length,
+    const char* language,
+    WhisperProgressiveCallback callback,
+    void* context
 ) {
-    *count = 0;
-
-    if (!model) {
-        return nullptr;
-    }
+    TranscriptionResult result = {nullptr, 0, nullptr, 0.0f, 0.0f};
 
-    auto buffer_it = streaming_buffers.find(model);
-    if (buffer_it == streaming_buffers.end()) {
-        std::cerr << "Streaming not started for this model" << std::endl;
-        return nullptr;
+    if (!model || !audio || audio_length == 0 || !callback) {
+        return result;
     }
 
-    auto buffer = buffer_it->second;
+    try {
+        auto* whisper_model = static_cast<WhisperModel*>(model);
+        auto* draft_whisper_model = static_cast<WhisperModel*>(draft_model);
 
-    // Check if we have a full 4-second window ready
+        std::vector<float> audio_vec(audio, audio + audio_length);
+        std::optional<std::string> lang = language ? std::optional<std::string>(language) : std::nullopt;
+
+        auto on_update = [callback, context](const ProgressiveUpdate& update) {
+            std::vector<TranscriptionSegment> segments;
+            segments.reserve(update.segments.size());
+            for (const auto& seg : update.segments) {
+                // Text stays owned by update.segments for the duration of the callback
+                segments.push_back({const_cast<char*>(seg.text.c_str()), seg.start, seg.end});
+            }
+            callback(context, update.pass == ProgressivePass::Final, update.start, update.end,
+                     segments.data(), segments.size());
+        };
+
+        auto [segments, info] = whisper_model->transcribe_progressive(
+            audio_vec, on_update, lang, true, "transcribe", draft_whisper_model
+        );
+        result = make_transcription_result(segments, info);
+
+    } catch (const std::exception& e) {
+        std::cerr << "Progressive transcription failed: " << e.what() << std::endl;
+    }
+
+    return result;
+}
+
+AlignmentResult whisper_align(
+    WhisperModelHandle model,
+    const float* audio,
+    unsigned long audio_length,
+    const char* const* texts,
+    const float* starts,
+    const float* ends,
+    unsigned long text_count,
+    const char* language
+) {
+    AlignmentResult result = {nullptr, 0, nullptr, 0.0f};
+
+    if (!model || !audio || audio_length == 0 || !texts || text_count == 0) {
+        return result;
+    }
+
+    try {
+        auto* whisper_model = static_cast<WhisperModel*>(model);
+
+        std::vector<AlignmentRequest> requests(text_count);
+        for (unsigned long i = 0; i < text_count; ++i) {
+            requests[i].text = texts[i] ? texts[i] : "";
+            if (starts && starts[i] >= 0.0f) {
+                requests[i].start = starts[i];
+                if (ends && ends[i] > starts[i]) {
+                    requests[i].end = ends[i];
+                }
+            }
+        }
+
+        std::vector<float> audio_vec(audio, audio + audio_length);
+        std::optional<std::string> lang = language ? std::optional<std::string>(language) : std::nullopt;
+        auto [segments, info] = whisper_model->align(audio_vec, requests, lang);
+
+        result.segments = static_cast<AlignmentSegment*>(calloc(segments.size(), sizeof(AlignmentSegment)));
+        result.segment_count = segments.size();
+        for (size_t i = 0; i < segments.size(); ++i) {
+            const auto& seg = segments[i];
+            auto& out = result.segments[i];
+
+            out.text = static_cast<char*>(malloc(seg.text.length() + 1));
+            std::strcpy(out.text, seg.text.c_str());
+            out.start = seg.start;
+            out.end = seg.end;
+
+            out.word_count = seg.words.size();
+            if (out.word_count > 0) {
+                out.words = static_cast<WordTiming*>(malloc(out.word_count * sizeof(WordTiming)));
+                for (size_t j = 0; j < seg.words.size(); ++j) {
+                    const auto& word = seg.words[j];
+                    out.words[j].word = static_cast<char*>(malloc(word.word.length() + 1));
+                    std::strcpy(out.words[j].word, word.word.c_str());
+                    out.words[j].start = word.start;
+                    out.words[j].end = word.end;
+                    out.words[j].probability = word.probability;
+                }
+            }
+        }
+
+        result.language = static_cast<char*>(malloc(info.language.length() + 1));
+        std::strcpy(result.language, info.language.c_str());
+        result.duration = info.duration;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Alignment failed: " << e.what() << std::endl;
+        whisper_free_alignment_result(result);
+        result = {nullptr, 0, nullptr, 0.0f};
+    }
+
+    return result;
+}
+
+// Lazy segment iterator
+
+WhisperSegmentIteratorHandle whisper_transcribe_iter(
+    WhisperModelHandle model,
+    const float* audio,
+    unsigned long audio_length,
+    const char* language,
+    const char* task,
+    double time_budget_seconds
+) {
+    if (!model || !audio || audio_length == 0) {
+        return nullptr;
+    }
+
+    try {
+        auto* whisper_model = static_cast<WhisperModel*>(model);
+
+        std::vector<float> audio_vec(audio, audio + audio_length);
+        std::optional<std::string> lang = language ? std::optional<std::string>(language) : std::nullopt;
+        std::optional<double> budget = time_budget_seconds > 0 ? std::optional<double>(time_budget_seconds) : std::nullopt;
+
+        auto iterator = whisper_model->transcribe_iter(audio_vec, lang, true, task ? std::string(task) : "transcribe", budget);
+        return iterator.release();
+
+    } catch (const std::exception& e) {
+        std::cerr << "Transcription failed: " << e.what() << std::endl;
+    }
+
+    return nullptr;
+}
+
+WhisperIteratorStatus whisper_iterator_next(
+    WhisperSegmentIteratorHandle iterator,
+    TranscriptionSegment* segment
+) {
+    if (!iterator || !segment) {
+        return WHISPER_ITERATOR_ERROR;
+    }
+    *segment = {nullptr, 0.0f, 0.0f};
+
+    try {
+        auto* segment_iterator = static_cast<SegmentIterator*>(iterator);
+
+        Segment seg;
+        if (segment_iterator->next(seg)) {
+            segment->text = static_cast<char*>(malloc(seg.text.length() + 1));
+            std::strcpy(segment->text, seg.text.c_str());
+            segment->start = seg.start;
+            segment->end = seg.end;
+            return WHISPER_ITERATOR_SEGMENT;
+        }
+
+        switch (segment_iterator->status()) {
+            case SegmentIterator::Status::Cancelled:
+                return WHISPER_ITERATOR_CANCELLED;
+            case SegmentIterator::Status::BudgetExceeded:
+                return WHISPER_ITERATOR_BUDGET_EXCEEDED;
+            default:
+                return WHISPER_ITERATOR_FINISHED;
+        }
+
+    } catch (const std::exception& e) {
+        std::cerr << "Transcription failed: " << e.what() << std::endl;
+    }
+
+    return WHISPER_ITERATOR_ERROR;
+}
+
+void whisper_iterator_cancel(WhisperSegmentIteratorHandle iterator) {
+    if (iterator) {
+        static_cast<SegmentIterator*>(iterator)->cancel();
+    }
+}
+
+float whisper_iterator_progress(WhisperSegmentIteratorHandle iterator) {
+    if (!iterator) {
+        return 0.0f;
+    }
+    return static_cast<SegmentIterator*>(iterator)->progress();
+}
+
+void whisper_destroy_iterator(WhisperSegmentIteratorHandle iterator) {
+    delete static_cast<SegmentIterator*>(iterator);
+}
+
+ByteArray whisper_iterator_checkpoint(WhisperSegmentIteratorHandle iterator) {
+    ByteArray result = {nullptr, 0};
+    if (!iterator) {
+        return result;
+    }
+
+    try {
+        std::vector<uint8_t> bytes = static_cast<SegmentIterator*>(iterator)->checkpoint().serialize();
+        result.data = static_cast<unsigned char*>(malloc(bytes.size()));
+        std::memcpy(result.data, bytes.data(), bytes.size());
+        result.length = bytes.size();
+
+    } catch (const std::exception& e) {
+        std::cerr << "Checkpoint failed: " << e.what() << std::endl;
+    }
+
+    return result;
+}
+
+WhisperSegmentIteratorHandle whisper_resume_iter(
+    WhisperModelHandle model,
+    const float* audio,
+    unsigned long audio_length,
+    const unsigned char* checkpoint,
+    unsigned long checkpoint_length,
+    double time_budget_seconds
+) {
+    if (!model || !audio || audio_length == 0 || !checkpoint || checkpoint_length == 0) {
+        return nullptr;
+    }
+
+    try {
+        auto* whisper_model = static_cast<WhisperModel*>(model);
+
+        TranscriptionCheckpoint state = TranscriptionCheckpoint::deserialize(checkpoint, checkpoint_length);
+        std::vector<float> audio_vec(audio, audio + audio_length);
+        std::optional<double> budget = time_budget_seconds > 0 ? std::optional<double>(time_budget_seconds) : std::nullopt;
+
+        return whisper_model->resume_iter(audio_vec, state, budget).release();
+
+    } catch (const std::exception& e) {
+        std::cerr << "Resuming transcription failed: " << e.what() << std::endl;
+    }
+
+    return nullptr;
+}
+
+// Streaming functions
+
+void whisper_start_streaming(
+    WhisperModelHandle model,
+    const char* language,
+    const char* task
+) {
+    whisper_start_streaming_with_config(model, language, task, nullptr);
+}
+
+bool whisper_start_streaming_with_config(
+    WhisperModelHandle model,
+    const char* language,
+    const char* task,
+    const WhisperStreamingConfig* config
+) {
+    if (!model) {
+        return false;
+    }
+
+    StreamingGeometry geometry;
+    try {
+        auto* whisper_model = static_cast<WhisperModel*>(model);
+        const float max_input_seconds = whisper_model->max_input_seconds();
+        if (config) {
+            geometry = StreamingGeometry::from_seconds(
+                config->sample_rate > 0 ? config->sample_rate : WHISPER_SAMPLE_RATE,
+                config->window_seconds > 0 ? config->window_seconds : 4.2f,
+                config->hop_seconds,
+                config->max_window_seconds,
+                config->auto_size,
+                max_input_seconds
+            );
+        } else {
+            geometry.max_window_samples = static_cast<size_t>(max_input_seconds * geometry.sample_rate);
+        }
+        geometry.validate(max_input_seconds);
+    } catch (const std::exception& e) {
+        std::cerr << "Invalid streaming configuration: " << e.what() << std::endl;
+        return false;
+    }
+
+    // Create streaming buffer with the session's sliding window
+    std::lock_guard<std::mutex> lock(streaming_mutex);
+    streaming_buffers[model] = std::make_shared<StreamingBuffer>(geometry);
+    streaming_contexts[model] = std::make_shared<StreamingContext>(
+        language && *language ? std::optional<std::string>(language) : std::nullopt,
+        task ? std::string(task) : "transcribe"
+    );
+    last_transcribed_position[model] = SIZE_MAX;  // Initialize to invalid position
+    return true;
+}
+
+float whisper_streaming_window_seconds(WhisperModelHandle model) {
+    if (!model) {
+        return 0.0f;
+    }
+
+    auto buffer = find_streaming_buffer(model);
+    if (!buffer) {
+        return 0.0f;
+    }
+
+    // The base window; catch-up windows are longer only while behind
+    return static_cast<float>(buffer->base_window_size()) / buffer->geometry().sample_rate;
+}
+
+float whisper_streaming_next_window_seconds(WhisperModelHandle model) {
+    if (!model) {
+        return 0.0f;
+    }
+
+    auto buffer = find_streaming_buffer(model);
+    if (!buffer) {
+        return 0.0f;
+    }
+
+    buffer->commit_pending();
+    return static_cast<float>(buffer->window_size()) / buffer->geometry().sample_rate;
+}
+
+void whisper_add_audio_chunk(
+    WhisperModelHandle model,
+    const float* chunk,
+    unsigned long chunk_length
+) {
+    if (!model || !chunk || chunk_length == 0) {
+        return;
+    }
+
+    auto buffer = find_streaming_buffer(model);
+    if (!buffer) {
+        std::cerr << "Streaming not started for this model" << std::endl;
+        return;
+    }
+
+    // Keep ordering with samples written through whisper_write_audio
+    buffer->commit_pending();
+    buffer->add_samples(chunk, chunk_length);
+}
+
+WhisperWriteStatus whisper_write_audio(
+    WhisperModelHandle model,
+    const float* samples,
+    unsigned long sample_count,
+    float energy_threshold,
+    float* energy
+) {
+    if (energy) {
+        *energy = 0.0f;
+    }
+
+    if (!model || !samples || sample_count == 0) {
+        return WHISPER_WRITE_DROPPED;
+    }
+
+    auto buffer = find_streaming_buffer(model);
+    if (!buffer) {
+        return WHISPER_WRITE_NOT_STREAMING;
+    }
+
+    // Mean absolute amplitude
+    float sum = 0.0f;
+    for (unsigned long i = 0; i < sample_count; ++i) {
+        sum += std::abs(samples[i]);
+    }
+    float chunk_energy = sum / static_cast<float>(sample_count);
+    if (energy) {
+        *energy = chunk_energy;
+    }
+
+    if (energy_threshold > 0.0f && chunk_energy < energy_threshold) {
+        return WHISPER_WRITE_DROPPED;
+    }
+
+    if (!buffer->write(samples, sample_count)) {
+        return WHISPER_WRITE_OVERFLOW;
+    }
+
+    return buffer->is_window_due() ? WHISPER_WRITE_WINDOW_READY : WHISPER_WRITE_BUFFERED;
+}
+
+bool whisper_attach_shared_ring(
+    WhisperModelHandle model,
+    const char* name,
+    unsigned long capacity_samples
+) {
+    if (!model || !name || capacity_samples == 0) {
+        return false;
+    }
+
+    auto buffer = find_streaming_buffer(model);
+    if (!buffer) {
+        std::cerr << "Streaming not started for this model" << std::endl;
+        return false;
+    }
+
+    try {
+        buffer->attach_shared_ring(SharedAudioRing::create(name, capacity_samples));
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to attach shared audio ring: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+int whisper_shared_ring_doorbell_fd(WhisperModelHandle model) {
+    if (!model) {
+        return -1;
+    }
+
+    auto buffer = find_streaming_buffer(model);
+    if (!buffer || !buffer->shared_ring()) {
+        return -1;
+    }
+
+    return buffer->shared_ring()->doorbell_fd();
+}
+
+WhisperSharedRingHandle whisper_shared_ring_open(const char* name, int doorbell_fd) {
+    if (!name) {
+        return nullptr;
+    }
+
+    try {
+        return SharedAudioRing::open(name, doorbell_fd).release();
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to open shared audio ring: " << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
+WhisperWriteStatus whisper_shared_ring_write(
+    WhisperSharedRingHandle ring,
+    const float* samples,
+    unsigned long sample_count
+) {
+    if (!ring) {
+        return WHISPER_WRITE_NOT_STREAMING;
+    }
+    if (!samples || sample_count == 0) {
+        return WHISPER_WRITE_DROPPED;
+    }
+
+    auto* shared_ring = static_cast<SharedAudioRing*>(ring);
+    if (shared_ring->is_closed()) {
+        return WHISPER_WRITE_NOT_STREAMING;
+    }
+    return shared_ring->write(samples, sample_count) ? WHISPER_WRITE_BUFFERED : WHISPER_WRITE_OVERFLOW;
+}
+
+void whisper_shared_ring_close(WhisperSharedRingHandle ring) {
+    delete static_cast<SharedAudioRing*>(ring);
+}
+
+bool whisper_is_window_ready(WhisperModelHandle model) {
+    if (!model) {
+        return false;
+    }
+
+    auto buffer = find_streaming_buffer(model);
+    if (!buffer) {
+        return false;
+    }
+
+    return buffer->is_window_due();
+}
+
+void whisper_trim_buffer(
+    WhisperModelHandle model,
+    unsigned long sample_count
+) {
+    if (!model || sample_count == 0) {
+        return;
+    }
+
+    auto buffer = find_streaming_buffer(model);
+    if (!buffer) {
+        std::cerr << "Streaming not started for this model" << std::endl;
+        return;
+    }
+
+    buffer->commit_pending();
+    if (buffer->size() >= sample_count) {
+        buffer->trim_samples(sample_count);
+        // Reset transcribed position since we trimmed
+        reset_window_position(model);
+    }
+}
+
+TranscriptionSegment* whisper_get_new_segments(
+    WhisperModelHandle model,
+    unsigned long* count
+) {
+    *count = 0;
+
+    if (!model) {
+        return nullptr;
+    }
+
+    // Hold on to the session: a concurrent whisper_stop_streaming only drops the maps' references
+    auto buffer = find_streaming_buffer(model);
+    auto context = find_streaming_context(model);
+    if (!buffer || !context) {
+        std::cerr << "Streaming not started for this model" << std::endl;
+        return nullptr;
+    }
+
+    // Pull in everything the capture thread has written so far
+    buffer->commit_pending();
+
+    // Check if we have a full window ready
     if (!buffer->is_ready_to_decode()) {
         return nullptr;
     }
 
     // Only transcribe if window position has changed since last transcription
-    size_t current_position = buffer->window_position();
-    if (last_transcribed_position[model] == current_position) {
-        return nullptr;  // Already transcribed at this position
+    // Marked as transcribed BEFORE we actually transcribe
+    // This prevents multiple transcriptions of the same window
+    if (!claim_window_position(model, buffer->window_position())) {
+        return nullptr;  // Already transcribed at this position, or streaming stopped
     }
 
-    // Mark this position as transcribed BEFORE we actually transcribe
-    // This prevents multiple transcriptions of the same window
-    last_transcribed_position[model] = current_position;
+    // One hop normally; when behind, the whole backlog (up to the maximum window) in a single window
+    const size_t trim_samples = buffer->window_shift();
 
     try {
         auto* whisper_model = static_cast<WhisperModel*>(model);
 
-        // Get 4-second window from current position
+        // Get the window from current position
+        if (buffer->is_catching_up()) {
+            std::cout << "#debug ⏩ Catching up: decoding " << std::fixed << std::setprecision(1)
+                      << static_cast<float>(buffer->window_size()) / buffer->geometry().sample_rate
+                      << "s backlog in one window" << std::endl;
+        }
         std::vector<float> window_audio = buffer->get_window();
+        const size_t window_samples = window_audio.size();
 
         #ifdef DEBUG
         // Skip transcribing dummy buffers in debug mode (used for flushing in tests)
@@ -551,100 +1337,280 @@ TranscriptionSegment* whisper_get_new_segments(
                       << window_audio.size() << " samples, all ~0.1)" << std::endl;
 
             // Still trim the buffer to advance the window
-            size_t trim_samples = 64000;  // 4 seconds at 16kHz
             if (buffer->size() >= trim_samples) {
                 buffer->trim_samples(trim_samples);
             }
-            last_transcribed_position[model] = SIZE_MAX;
+            reset_window_position(model);
 
             return nullptr;
         }
         #endif
 
-        std::optional<std::string> lang = streaming_language[model].empty() ?
-            std::nullopt : std::optional<std::string>(streaming_language[model]);
-
-        std::string task = streaming_task[model];
-        std::vector<Segment> segments;
-        TranscriptionInfo info;
-
-        if (task == "translate") {
-            auto [trans_segs, trans_info] = whisper_model->translate(window_audio, lang);
-            segments = trans_segs;
-            info = trans_info;
-        } else {
-            auto [trans_segs, trans_info] = whisper_model->transcribe(window_audio, lang, true);
-            segments = trans_segs;
-            info = trans_info;
+        // Decode with the session's token history as the prompt
+        if (buffer->geometry().sample_rate != WHISPER_SAMPLE_RATE) {
+            window_audio = whisper::AudioProcessor::resample_audio(window_audio, buffer->geometry().sample_rate);
         }
+        auto decode_start = std::chrono::steady_clock::now();
+        auto [segments, info] = whisper_model->transcribe_streaming(window_audio, *context);
+        buffer->record_decode(
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - decode_start).count(),
+            window_samples
+        );
 
         // Filter out hallucinations
-        std::vector<Segment> filtered_segments;
-        for (const auto& seg : segments) {
-            std::string trimmed_text = seg.text;
-            // Trim whitespace
-            size_t start = trimmed_text.find_first_not_of(" \t\n\r");
-            size_t end = trimmed_text.find_last_not_of(" \t\n\r");
-            if (start != std::string::npos && end != std::string::npos) {
-                trimmed_text = trimmed_text.substr(start, end - start + 1);
-            }
+        std::vector<Segment> filtered_segments = filter_hallucinations(segments);
 
-            // Skip hallucinations
-            if (!isHallucination(trimmed_text)) {
-                filtered_segments.push_back(seg);
-            } else {
-                std::cout << "#debug ⚠️  Filtered hallucination: \"" << trimmed_text << "\"" << std::endl;
-            }
-        }
+        // Only emitted text conditions the next window; hallucinations would feed on themselves
+        context->update(segments, filtered_segments);
 
         // Emit all non-hallucination segments immediately
-        // Trim by 4 seconds, leaving 0.2s in buffer for overlap with next window
-        size_t trim_samples = 64000;  // 4 seconds at 16kHz
+        // Trim the decoded window, leaving the overlap in buffer for the next window
         if (buffer->size() >= trim_samples) {
             buffer->trim_samples(trim_samples);
         }
 
         // Reset transcribed position since we trimmed (buffer reset to position 0)
-        last_transcribed_position[model] = SIZE_MAX;
+        reset_window_position(model);
 
         // Allocate and copy all filtered segments
-        *count = filtered_segments.size();
-        if (*count > 0) {
-            TranscriptionSegment* result = static_cast<TranscriptionSegment*>(
-                malloc(*count * sizeof(TranscriptionSegment))
-            );
+        return make_segment_array(filtered_segments, count);
 
-            for (size_t i = 0; i < filtered_segments.size(); ++i) {
-                const auto& seg = filtered_segments[i];
+    } catch (const std::exception& e) {
+        std::cerr << "Streaming transcription failed: " << e.what() << std::endl;
 
-                // Allocate and copy text
-                result[i].text = static_cast<char*>(malloc(seg.text.length() + 1));
-                std::strcpy(result[i].text, seg.text.c_str());
+        // Skip the failed window so a consumer waiting on whisper_is_window_ready keeps advancing
+        if (buffer->size() >= trim_samples) {
+            buffer->trim_samples(trim_samples);
+        }
+        reset_window_position(model);
+    }
 
-                result[i].start = seg.start;
-                result[i].end = seg.end;
-            }
+    return nullptr;
+}
+
+void whisper_stop_streaming(WhisperModelHandle model) {
+    if (!model) {
+        return;
+    }
 
+    // Clean up streaming resources
+    erase_streaming_state(model);
+}
+
+ByteArray whisper_streaming_snapshot(WhisperModelHandle model) {
+    ByteArray result = {nullptr, 0};
+    if (!model) {
+        return result;
+    }
+
+    std::shared_ptr<StreamingBuffer> buffer;
+    std::shared_ptr<StreamingContext> context;
+    {
+        std::lock_guard<std::mutex> lock(streaming_mutex);
+        auto buffer_it = streaming_buffers.find(model);
+        auto context_it = streaming_contexts.find(model);
+        if (buffer_it == streaming_buffers.end() || context_it == streaming_contexts.end()) {
+            std::cerr << "Streaming not started for this model" << std::endl;
             return result;
         }
+        buffer = buffer_it->second;
+        context = context_it->second;
+    }
+
+    try {
+        std::vector<uint8_t> bytes = StreamingSnapshot::capture(*buffer, *context).serialize();
+        result.data = static_cast<unsigned char*>(malloc(bytes.size()));
+        std::memcpy(result.data, bytes.data(), bytes.size());
+        result.length = bytes.size();
 
     } catch (const std::exception& e) {
-        std::cerr << "Streaming transcription failed: " << e.what() << std::endl;
+        std::cerr << "Streaming snapshot failed: " << e.what() << std::endl;
     }
 
-    return nullptr;
+    return result;
 }
 
-void whisper_stop_streaming(WhisperModelHandle model) {
+bool whisper_streaming_restore(
+    WhisperModelHandle model,
+    const unsigned char* snapshot,
+    unsigned long snapshot_length
+) {
+    if (!model || !snapshot || snapshot_length == 0) {
+        return false;
+    }
+
+    std::shared_ptr<StreamingBuffer> buffer;
+    std::shared_ptr<StreamingContext> context;
+    try {
+        StreamingSnapshot state = StreamingSnapshot::deserialize(snapshot, snapshot_length);
+        state.geometry.validate(static_cast<WhisperModel*>(model)->max_input_seconds());
+        buffer = state.restore_buffer();
+        context = state.restore_context();
+    } catch (const std::exception& e) {
+        std::cerr << "Restoring streaming session failed: " << e.what() << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(streaming_mutex);
+    streaming_buffers[model] = buffer;
+    streaming_contexts[model] = context;
+    last_transcribed_position[model] = SIZE_MAX;
+    return true;
+}
+
+// Split streaming (features extracted on the capture device)
+
+struct FeatureEncoderState {
+    FeatureExtractor extractor;
+    FeatureStreamEncoder encoder;
+};
+
+struct FeatureSession {
+    WhisperModel* model;
+    StreamingContext context;
+    FeatureStreamDecoder decoder;
+};
+
+WhisperFeatureEncoderHandle whisper_feature_encoder_create(WhisperFeatureEncoding encoding, unsigned int n_mels) {
+    try {
+        auto* state = new FeatureEncoderState{
+            FeatureExtractor(n_mels > 0 ? static_cast<int>(n_mels) : 80, WHISPER_SAMPLE_RATE, 160, 30, 400),
+            FeatureStreamEncoder(encoding == WHISPER_FEATURES_FP16 ? FeatureEncoding::Float16 : FeatureEncoding::Int8)
+        };
+        return state;
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to create feature encoder: " << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
+ByteArray whisper_feature_encode_window(
+    WhisperFeatureEncoderHandle encoder,
+    const float* audio,
+    unsigned long audio_length
+) {
+    ByteArray result = {nullptr, 0};
+    if (!encoder || !audio || audio_length == 0) {
+        return result;
+    }
+
+    try {
+        auto* state = static_cast<FeatureEncoderState*>(encoder);
+        std::vector<float> audio_vec(audio, audio + audio_length);
+        std::vector<uint8_t> bytes = state->encoder.encode_window(state->extractor.extract(audio_vec), audio_length);
+        result.data = static_cast<unsigned char*>(malloc(bytes.size()));
+        std::memcpy(result.data, bytes.data(), bytes.size());
+        result.length = bytes.size();
+
+    } catch (const std::exception& e) {
+        std::cerr << "Feature encoding failed: " << e.what() << std::endl;
+    }
+
+    return result;
+}
+
+void whisper_feature_encoder_destroy(WhisperFeatureEncoderHandle encoder) {
+    delete static_cast<FeatureEncoderState*>(encoder);
+}
+
+FloatMatrix whisper_feature_decode(
+    const unsigned char* data,
+    unsigned long length,
+    unsigned long* dropped_windows
+) {
+    FloatMatrix result = {nullptr, 0, 0};
+    if (dropped_windows) {
+        *dropped_windows = 0;
+    }
+    if (!data || length == 0) {
+        return result;
+    }
+
+    FeatureStreamDecoder decoder;
+    std::vector<FeatureWindow> windows;
+    try {
+        decoder.push(data, length, windows);
+    } catch (const std::exception& e) {
+        std::cerr << "Malformed feature packets: " << e.what() << std::endl;
+    }
+
+    if (dropped_windows) {
+        *dropped_windows = decoder.dropped_windows();
+    }
+    return windows.empty() ? result : make_float_matrix(windows.front().features);
+}
+
+WhisperFeatureSessionHandle whisper_feature_session_create(
+    WhisperModelHandle model,
+    const char* language,
+    const char* task
+) {
     if (!model) {
-        return;
+        return nullptr;
     }
 
-    // Clean up streaming resources
-    streaming_buffers.erase(model);
-    streaming_language.erase(model);
-    streaming_task.erase(model);
-    last_transcribed_position.erase(model);
+    return new FeatureSession{
+        static_cast<WhisperModel*>(model),
+        StreamingContext(
+            language && *language ? std::optional<std::string>(language) : std::nullopt,
+            task ? std::string(task) : "transcribe"
+        ),
+        FeatureStreamDecoder()
+    };
+}
+
+TranscriptionSegment* whisper_feature_session_push(
+    WhisperFeatureSessionHandle session,
+    const unsigned char* data,
+    unsigned long length,
+    unsigned long* count
+) {
+    *count = 0;
+    if (!session || !data || length == 0) {
+        return nullptr;
+    }
+
+    auto* feature_session = static_cast<FeatureSession*>(session);
+    std::vector<FeatureWindow> windows;
+    try {
+        feature_session->decoder.push(data, length, windows);
+    } catch (const std::exception& e) {
+        // Windows completed before the malformed packet are still transcribed
+        std::cerr << "Malformed feature packets: " << e.what() << std::endl;
+    }
+
+    std::vector<Segment> filtered_segments;
+    for (const auto& window : windows) {
+        try {
+            const float duration = static_cast<float>(window.window_samples) / WHISPER_SAMPLE_RATE;
+            auto [segments, info] = feature_session->model->transcribe_streaming_features(
+                window.features, duration, feature_session->context
+            );
+
+            std::vector<Segment> window_segments = filter_hallucinations(segments);
+            feature_session->context.update(segments, window_segments);
+            filtered_segments.insert(filtered_segments.end(), window_segments.begin(), window_segments.end());
+
+        } catch (const std::exception& e) {
+            std::cerr << "Streaming transcription of feature window " << window.window << " failed: " << e.what() << std::endl;
+        }
+    }
+
+    return make_segment_array(filtered_segments, count);
+}
+
+unsigned long whisper_feature_session_dropped_windows(WhisperFeatureSessionHandle session) {
+    return session ? static_cast<FeatureSession*>(session)->decoder.dropped_windows() : 0;
+}
+
+void whisper_feature_session_destroy(WhisperFeatureSessionHandle session) {
+    delete static_cast<FeatureSession*>(session);
+}
+
+void whisper_free_byte_array(ByteArray array) {
+    if (array.data) {
+        free(array.data);
+    }
 }
 
 void whisper_free_transcription_result(TranscriptionResult result) {
@@ -661,6 +1627,40 @@ void whisper_free_transcription_result(TranscriptionResult result) {
     }
 }
 
+void whisper_free_stereo_transcription_result(StereoTranscriptionResult result) {
+    whisper_free_transcription_result(result.left);
+    whisper_free_transcription_result(result.right);
+}
+
+void whisper_free_alignment_result(AlignmentResult result) {
+    if (result.segments) {
+        for (unsigned long i = 0; i < result.segment_count; ++i) {
+            AlignmentSegment& segment = result.segments[i];
+            for (unsigned long j = 0; j < segment.word_count; ++j) {
+                if (segment.words[j].word) {
+                    free(segment.words[j].word);
+                }
+            }
+            if (segment.words) {
+                free(segment.words);
+            }
+            if (segment.text) {
+                free(segment.text);
+            }
+        }
+        free(result.segments);
+    }
+    if (result.language) {
+        free(result.language);
+    }
+}
+
+void whisper_free_segment(TranscriptionSegment segment) {
+    if (segment.text) {
+        free(segment.text);
+    }
+}
+
 void whisper_free_segments(TranscriptionSegment* segments, unsigned long count) {
     if (segments) {
         for (unsigned long i = 0; i < count; ++i) {
@@ -0,0 +1,49 @@
+//
+// audio_ring_buffer.cpp
+// SwiftFasterWhisper
+//
+// Created by Amr Aboelela on 10/18/2026.
+//
+
+#include "audio_ring_buffer.h"
+#include <algorithm>
+#include <cstring>
+
+AudioRingBuffer::AudioRingBuffer(size_t capacity) {
+    size_t rounded = 1;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+    data_.resize(rounded);
+    mask_ = rounded - 1;
+}
+
+bool AudioRingBuffer::write(const float* samples, size_t count) {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    const size_t tail = tail_.load(std::memory_order_acquire);
+    if (count > data_.size() - (head - tail)) {
+        return false;  // Not enough room, drop the whole chunk
+    }
+
+    const size_t start = head & mask_;
+    const size_t first = std::min(count, data_.size() - start);
+    std::memcpy(data_.data() + start, samples, first * sizeof(float));
+    if (first < count) {
+        std::memcpy(data_.data(), samples + first, (count - first) * sizeof(float));
+    }
+
+    head_.store(head + count, std::memory_order_release);
+    return true;
+}
+
+size_t AudioRingBuffer::available() const {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+}
+
+size_t AudioRingBuffer::capacity() const {
+    return data_.size();
+}
+
+void AudioRingBuffer::clear() {
+    tail_.store(head_.load(std::memory_order_acquire), std::memory_order_release);
+}
@@ -0,0 +1,108 @@
+//
+// batch_loader.cpp
+// SwiftFasterWhisper
+//
+// Created by Amr Aboelela on 10/18/2026.
+//
+
+#include "batch_loader.h"
+#include "whisper/whisper_audio.h"
+#include "time_compression.h"
+#include <algorithm>
+#include <exception>
+
+BatchLoader::BatchLoader(std::vector<std::string> paths,
+                         FeatureExtractor& extractor,
+                         size_t prefetch,
+                         size_t workers,
+                         float time_compression)
+    : paths_(std::move(paths)),
+      extractor_(extractor),
+      prefetch_(std::max<size_t>(prefetch, 1)),
+      time_compression_(time_compression)
+{
+    const size_t count = std::min(std::max<size_t>(workers, 1), std::max<size_t>(paths_.size(), 1));
+    for (size_t i = 0; i < count; ++i) {
+        workers_.emplace_back(&BatchLoader::worker_loop, this);
+    }
+}
+
+BatchLoader::~BatchLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    space_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+bool BatchLoader::next(LoadedAudio& loaded) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (next_to_return_ >= paths_.size()) {
+        return false;
+    }
+
+    ready_.wait(lock, [this] { return loaded_.count(next_to_return_) > 0; });
+    auto it = loaded_.find(next_to_return_);
+    loaded = std::move(it->second);
+    loaded_.erase(it);
+    next_to_return_++;
+
+    lock.unlock();
+    space_.notify_all();
+    return true;
+}
+
+void BatchLoader::worker_loop() {
+    while (true) {
+        size_t index;
+        {
+            // Claim the next file once it fits in the prefetch window
+            std::unique_lock<std::mutex> lock(mutex_);
+            space_.wait(lock, [this] {
+                return stopping_ || next_to_claim_ >= paths_.size() || next_to_claim_ < next_to_return_ + prefetch_;
+            });
+            if (stopping_ || next_to_claim_ >= paths_.size()) {
+                return;
+            }
+            index = next_to_claim_++;
+        }
+
+        LoadedAudio loaded = load(index);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            loaded_.emplace(index, std::move(loaded));
+        }
+        ready_.notify_all();
+    }
+}
+
+LoadedAudio BatchLoader::load(size_t index) const {
+    LoadedAudio loaded;
+    loaded.index = index;
+    loaded.path = paths_[index];
+
+    try {
+        std::vector<float> audio = whisper::AudioProcessor::load_audio(loaded.path);
+        if (audio.empty()) {
+            loaded.error = "Failed to load audio file: " + loaded.path;
+            return loaded;
+        }
+        loaded.duration = static_cast<float>(audio.size()) / extractor_.sampling_rate();
+        if (time_compression_ > 1.0f) {
+            audio = whisper::compress_time(audio, time_compression_, loaded.time_map, extractor_.sampling_rate());
+        }
+        loaded.features = extractor_.extract(audio);
+        if (loaded.features.empty() || loaded.features[0].empty()) {
+            loaded.error = "Failed to extract features from audio: " + loaded.path;
+            loaded.features.clear();
+        }
+    } catch (const std::exception& e) {
+        loaded.error = e.what();
+        loaded.features.clear();
+    }
+    return loaded;
+}
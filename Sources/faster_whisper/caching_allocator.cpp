@@ -0,0 +1,112 @@
+//
+// caching_allocator.cpp
+// SwiftFasterWhisper
+//
+// Created by Amr Aboelela on 10/18/2026.
+//
+
+#include "caching_allocator.h"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+CachingAllocator::CachingAllocator(size_t alignment)
+    : alignment_(std::max<size_t>(alignment, sizeof(void*)))
+{
+}
+
+CachingAllocator::~CachingAllocator() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& entry : free_blocks_) {
+        for (void* block : entry.second) {
+            std::free(block);
+        }
+    }
+    // Release blocks that were never handed back as well
+    for (auto& entry : block_sizes_) {
+        std::free(entry.first);
+    }
+}
+
+void* CachingAllocator::allocate(size_t size, int /*device_index*/) {
+    const size_t bytes = bucket_size(size);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    void* block = nullptr;
+
+    auto it = free_blocks_.find(bytes);
+    if (it != free_blocks_.end() && !it->second.empty()) {
+        block = it->second.back();
+        it->second.pop_back();
+        stats_.hits++;
+    } else {
+        block = system_allocate(bytes);
+        stats_.misses++;
+        stats_.bytes_reserved += bytes;
+    }
+
+    block_sizes_[block] = bytes;
+    stats_.bytes_in_use += bytes;
+    stats_.peak_bytes_in_use = std::max(stats_.peak_bytes_in_use, stats_.bytes_in_use);
+    return block;
+}
+
+void CachingAllocator::free(void* ptr, int /*device_index*/) {
+    if (!ptr) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = block_sizes_.find(ptr);
+    if (it == block_sizes_.end()) {
+        return;  // Not ours
+    }
+
+    const size_t bytes = it->second;
+    block_sizes_.erase(it);
+    stats_.bytes_in_use -= bytes;
+    free_blocks_[bytes].push_back(ptr);
+}
+
+void CachingAllocator::clear_cache() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& entry : free_blocks_) {
+        for (void* block : entry.second) {
+            std::free(block);
+            stats_.bytes_reserved -= entry.first;
+        }
+    }
+    free_blocks_.clear();
+}
+
+void CachingAllocator::reserve(size_t size, size_t count) {
+    const size_t bytes = bucket_size(size);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& blocks = free_blocks_[bytes];
+    while (blocks.size() < count) {
+        blocks.push_back(system_allocate(bytes));
+        stats_.bytes_reserved += bytes;
+    }
+}
+
+CachingAllocator::Stats CachingAllocator::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+size_t CachingAllocator::bucket_size(size_t size) const {
+    // Round up to the page granularity (itself a multiple of the alignment) so that
+    // slightly different requests for the same tensor shape share a bucket
+    const size_t granularity = std::max(BUCKET_GRANULARITY, alignment_);
+    const size_t rounded = ((std::max<size_t>(size, 1) + granularity - 1) / granularity) * granularity;
+    return rounded;
+}
+
+void* CachingAllocator::system_allocate(size_t bytes) {
+    void* block = nullptr;
+    if (posix_memalign(&block, alignment_, bytes) != 0 || !block) {
+        throw std::bad_alloc();
+    }
+    return block;
+}
@@ -99,7 +99,8 @@ FeatureExtractor::FeatureExtractor(
   n_samples = chunk_length * sampling_rate_;
   nb_max_frames_ = n_samples / hop_length;
   time_per_frame_ = (float)hop_length / sampling_rate_;
-  mel_filters = get_mel_filters(sampling_rate, n_fft, feature_size);
+  plan_ = whisper::FeaturePlan::get(sampling_rate, n_fft, hop_length, feature_size);
+  mel_filters = plan_->mel_filters;
 }
 
 Matrix FeatureExtractor::get_mel_filters(int sr, int n_fft, int n_mels) {
@@ -271,27 +272,8 @@ Matrix FeatureExtractor::compute_mel_spectrogram(
   // }
   // std::cout << "]" << std::endl;
 
-  // Log window statistics before STFT (to match Python's order)
-  auto window = whisper::AudioProcessor::apply_hann_window(WHISPER_N_FFT);
-  // float win_min = *std::min_element(window.begin(), window.end());
-  // float win_max = *std::max_element(window.begin(), window.end());
-  // double win_sum = std::accumulate(window.begin(), window.end(), 0.0);
-  // float win_mean = win_sum / window.size();
-  // std::cout << "  Window stats: min=" << std::fixed << std::setprecision(6) << win_min << ", max=" << win_max << ", mean=" << win_mean << std::endl;
-
-  // Print first 10 window values
-  // std::cout << "  First 10 window values: [";
-  // for (size_t i = 0; i < std::min(size_t(10), window.size()); ++i) {
-  //   if (i > 0) std::cout << " ";
-  //   // Add line break after 5th value to match Python's display
-  //   if (i == 5) std::cout << "\n ";
-  //   std::cout << std::scientific << std::setprecision(7) << window[i];
-  // }
-  // std::cout << "]" << std::endl;
-  // std::cout << std::fixed; // Reset to fixed notation
-
   // Use whisper-compatible mel spectrogram extraction
-  auto whisper_mel_spec = whisper::AudioProcessor::extract_mel_spectrogram(audio_to_process);
+  auto whisper_mel_spec = whisper::AudioProcessor::extract_mel_spectrogram(audio_to_process, *plan_);
 
   if (whisper_mel_spec.empty()) {
     std::cerr << "Failed to extract mel spectrogram using whisper audio processing" << std::endl;
@@ -0,0 +1,285 @@
+//
+// feature_stream.cpp
+// SwiftFasterWhisper
+//
+// Created by Amr Aboelela on 10/18/2026.
+//
+
+#include "feature_stream.h"
+#include "byte_stream.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+constexpr char MAGIC[4] = {'F', 'W', 'M', 'F'};
+constexpr uint8_t VERSION = 1;
+constexpr uint8_t FLAG_FIRST = 1;
+constexpr uint8_t FLAG_LAST = 2;
+constexpr size_t MAX_U16 = std::numeric_limits<uint16_t>::max();
+
+/// IEEE 754 single to half precision, rounding to nearest even
+uint16_t float_to_half(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint32_t sign = (bits >> 16) & 0x8000;
+    const uint32_t float_exponent = (bits >> 23) & 0xff;
+    uint32_t mantissa = bits & 0x7fffff;
+
+    if (float_exponent == 0xff) {
+        return static_cast<uint16_t>(sign | 0x7c00 | (mantissa ? 0x200 : 0));  // Inf or NaN
+    }
+    const int32_t exponent = static_cast<int32_t>(float_exponent) - 127 + 15;
+    if (exponent >= 31) {
+        return static_cast<uint16_t>(sign | 0x7c00);  // Overflow to infinity
+    }
+    if (exponent <= 0) {
+        if (exponent < -10) {
+            return static_cast<uint16_t>(sign);  // Underflow to zero
+        }
+        // Subnormal half
+        mantissa |= 0x800000;
+        const uint32_t shift = static_cast<uint32_t>(14 - exponent);
+        uint32_t half_mantissa = mantissa >> shift;
+        const uint32_t remainder = mantissa & ((1u << shift) - 1);
+        const uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half_mantissa & 1))) {
+            half_mantissa++;
+        }
+        return static_cast<uint16_t>(sign | half_mantissa);
+    }
+
+    uint32_t half = sign | (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+    const uint32_t remainder = mantissa & 0x1fff;
+    if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1))) {
+        half++;  // A carry into the exponent is still the correctly rounded value
+    }
+    return static_cast<uint16_t>(half);
+}
+
+float half_to_float(uint16_t half) {
+    const uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+    int32_t exponent = (half >> 10) & 0x1f;
+    uint32_t mantissa = half & 0x3ff;
+    uint32_t bits;
+
+    if (exponent == 0) {
+        if (mantissa == 0) {
+            bits = sign;
+        } else {
+            // Subnormal half: normalize into a float
+            exponent = 1;
+            while (!(mantissa & 0x400)) {
+                mantissa <<= 1;
+                exponent--;
+            }
+            mantissa &= 0x3ff;
+            bits = sign | (static_cast<uint32_t>(exponent + 112) << 23) | (mantissa << 13);
+        }
+    } else if (exponent == 31) {
+        bits = sign | 0x7f800000 | (mantissa << 13);
+    } else {
+        bits = sign | (static_cast<uint32_t>(exponent + 112) << 23) | (mantissa << 13);
+    }
+
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+}
+
+FeatureStreamEncoder::FeatureStreamEncoder(FeatureEncoding encoding, size_t frames_per_packet)
+    : encoding_(encoding),
+      frames_per_packet_(std::min(std::max<size_t>(frames_per_packet, 1), MAX_U16))
+{
+}
+
+std::vector<uint8_t> FeatureStreamEncoder::encode_window(const std::vector<std::vector<float>>& features,
+                                                         size_t window_samples) {
+    const size_t n_mels = features.size();
+    const size_t frames = n_mels > 0 ? features[0].size() : 0;
+    if (n_mels > MAX_U16) {
+        throw std::invalid_argument("Too many mel bins for a feature packet");
+    }
+
+    const size_t value_size = encoding_ == FeatureEncoding::Int8 ? 1 : 2;
+    const size_t packets = std::max<size_t>((frames + frames_per_packet_ - 1) / frames_per_packet_, 1);
+    ByteWriter writer;
+    writer.bytes().reserve(packets * (feature_stream::HEADER_SIZE + 8) + frames * n_mels * value_size);
+
+    const uint32_t window = next_window_++;
+    for (size_t packet = 0; packet < packets; ++packet) {
+        const size_t first_frame = packet * frames_per_packet_;
+        const size_t frame_count = std::min(frames_per_packet_, frames - std::min(first_frame, frames));
+
+        uint8_t flags = 0;
+        if (packet == 0) {
+            flags |= FLAG_FIRST;
+        }
+        if (packet + 1 == packets) {
+            flags |= FLAG_LAST;
+        }
+
+        for (char c : MAGIC) {
+            writer.u8(static_cast<uint8_t>(c));
+        }
+        writer.u8(VERSION);
+        writer.u8(static_cast<uint8_t>(encoding_));
+        writer.u8(flags);
+        writer.u8(0);
+        writer.u16(static_cast<uint16_t>(n_mels));
+        writer.u16(static_cast<uint16_t>(frame_count));
+        writer.u32(next_sequence_++);
+        writer.u32(window);
+        writer.u32(static_cast<uint32_t>(window_samples));
+
+        if (encoding_ == FeatureEncoding::Int8) {
+            // One offset and scale per packet maps its value range onto 0...255
+            float low = std::numeric_limits<float>::infinity();
+            float high = -std::numeric_limits<float>::infinity();
+            for (size_t mel = 0; mel < n_mels; ++mel) {
+                for (size_t frame = first_frame; frame < first_frame + frame_count; ++frame) {
+                    low = std::min(low, features[mel][frame]);
+                    high = std::max(high, features[mel][frame]);
+                }
+            }
+            if (frame_count == 0) {
+                low = high = 0.0f;
+            }
+            const float scale = (high - low) / 255.0f;
+            writer.f32(low);
+            writer.f32(scale);
+
+            for (size_t frame = first_frame; frame < first_frame + frame_count; ++frame) {
+                for (size_t mel = 0; mel < n_mels; ++mel) {
+                    long code = scale > 0.0f ? std::lround((features[mel][frame] - low) / scale) : 0;
+                    writer.u8(static_cast<uint8_t>(std::min(std::max(code, 0L), 255L)));
+                }
+            }
+        } else {
+            for (size_t frame = first_frame; frame < first_frame + frame_count; ++frame) {
+                for (size_t mel = 0; mel < n_mels; ++mel) {
+                    writer.u16(float_to_half(features[mel][frame]));
+                }
+            }
+        }
+    }
+    return std::move(writer.bytes());
+}
+
+void FeatureStreamDecoder::drop_pending() {
+    dropped_windows_++;
+    skipping_ = true;
+    skipped_window_ = pending_.window;
+    has_pending_ = false;
+    pending_ = FeatureWindow();
+}
+
+void FeatureStreamDecoder::push(const uint8_t* data, size_t size, std::vector<FeatureWindow>& completed) {
+    ByteReader reader(data, size, "Feature packet");
+    while (reader.remaining() > 0) {
+        try {
+            read_packet(reader, completed);
+        } catch (const std::exception&) {
+            // The window being reassembled cannot be trusted past a malformed packet
+            if (has_pending_) {
+                drop_pending();
+            }
+            throw;
+        }
+    }
+}
+
+void FeatureStreamDecoder::read_packet(ByteReader& reader, std::vector<FeatureWindow>& completed) {
+    reader.require(feature_stream::HEADER_SIZE);
+    for (char c : MAGIC) {
+        if (reader.u8() != static_cast<uint8_t>(c)) {
+            throw std::runtime_error("Not a feature packet");
+        }
+    }
+    const uint8_t version = reader.u8();
+    if (version != VERSION) {
+        throw std::runtime_error("Unsupported feature packet version " + std::to_string(version));
+    }
+    const uint8_t encoding_code = reader.u8();
+    if (encoding_code > static_cast<uint8_t>(FeatureEncoding::Int8)) {
+        throw std::runtime_error("Unknown feature encoding " + std::to_string(encoding_code));
+    }
+    const auto encoding = static_cast<FeatureEncoding>(encoding_code);
+    const uint8_t flags = reader.u8();
+    reader.u8();  // Reserved
+    const size_t n_mels = reader.u16();
+    const size_t frame_count = reader.u16();
+    const uint32_t sequence = reader.u32();
+    const uint32_t window = reader.u32();
+    const uint32_t window_samples = reader.u32();
+
+    if (n_mels == 0) {
+        throw std::runtime_error("Feature packet has no mel bins");
+    }
+    const size_t payload = (encoding == FeatureEncoding::Int8 ? 8 + frame_count * n_mels : 2 * frame_count * n_mels);
+    reader.require(payload);
+
+    // A gap in the sequence loses part of the window being reassembled
+    const bool lost = has_sequence_ && sequence != expected_sequence_;
+    has_sequence_ = true;
+    expected_sequence_ = sequence + 1;
+    if (lost && has_pending_) {
+        drop_pending();
+    }
+
+    bool keep = true;
+    if (flags & FLAG_FIRST) {
+        if (has_pending_) {
+            drop_pending();  // The previous window never got its last packet
+        }
+        pending_ = FeatureWindow();
+        pending_.window = window;
+        pending_.window_samples = window_samples;
+        pending_.features.assign(n_mels, std::vector<float>());
+        has_pending_ = true;
+        skipping_ = false;
+    } else if (!has_pending_ || pending_.window != window) {
+        // The rest of a window whose earlier packets were lost
+        if (!skipping_ || skipped_window_ != window) {
+            dropped_windows_++;
+            skipping_ = true;
+            skipped_window_ = window;
+        }
+        keep = false;
+    } else if (pending_.features.size() != n_mels) {
+        throw std::runtime_error("Feature packets of one window disagree on the number of mel bins");
+    }
+
+    if (encoding == FeatureEncoding::Int8) {
+        const float offset = reader.f32();
+        const float scale = reader.f32();
+        for (size_t frame = 0; frame < frame_count; ++frame) {
+            for (size_t mel = 0; mel < n_mels; ++mel) {
+                const uint8_t code = reader.u8();
+                if (keep) {
+                    pending_.features[mel].push_back(offset + code * scale);
+                }
+            }
+        }
+    } else {
+        for (size_t frame = 0; frame < frame_count; ++frame) {
+            for (size_t mel = 0; mel < n_mels; ++mel) {
+                const uint16_t half = reader.u16();
+                if (keep) {
+                    pending_.features[mel].push_back(half_to_float(half));
+                }
+            }
+        }
+    }
+
+    if (keep && (flags & FLAG_LAST)) {
+        completed.push_back(std::move(pending_));
+        pending_ = FeatureWindow();
+        has_pending_ = false;
+    }
+}
@@ -16,10 +16,7 @@ public:
       int sampling_rate = 16000
   );
 
-  static std::pair<std::vector<float>, std::vector<float>> decode_audio_split_stereo(
-    const std::string& input_file,
-    int sampling_rate = 16000
-  );
+  // Stereo files with one speaker per channel: use whisper::AudioProcessor::load_audio_split_stereo
 
   // Pads or trims a 1D vector to a specific length.
   static std::vector<float> pad_or_trim(
@@ -0,0 +1,71 @@
+//
+// audio_ring_buffer.h
+// SwiftFasterWhisper
+//
+// Created by Amr Aboelela on 10/18/2026.
+//
+
+#ifndef AUDIO_RING_BUFFER_H
+#define AUDIO_RING_BUFFER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/// AudioRingBuffer is a lock-free single-producer/single-consumer ring of float samples
+/// The capture side writes while the decoding side reads, without locks or per-chunk allocations
+class AudioRingBuffer {
+public:
+    /// Constructor
+    /// @param capacity Minimum number of samples the ring can hold (rounded up to a power of two)
+    explicit AudioRingBuffer(size_t capacity);
+
+    /// Write samples (producer side)
+    /// All-or-nothing: if the ring cannot hold every sample, nothing is written
+    /// @param samples Samples to copy into the ring
+    /// @param count Number of samples
+    /// @return true if the samples were written
+    bool write(const float* samples, size_t count);
+
+    /// Hand every readable sample to a callback and release it (consumer side)
+    /// The callback is invoked with at most two contiguous spans, oldest first
+    /// @param consume Callback taking (const float* samples, size_t count)
+    /// @return Number of samples consumed
+    template <typename Consumer>
+    size_t consume_all(Consumer&& consume) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t head = head_.load(std::memory_order_acquire);
+        const size_t count = head - tail;
+        if (count == 0) {
+            return 0;
+        }
+
+        const size_t start = tail & mask_;
+        const size_t first = std::min(count, data_.size() - start);
+        consume(data_.data() + start, first);
+        if (first < count) {
+            consume(data_.data(), count - first);
+        }
+
+        tail_.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    /// Number of samples waiting to be consumed (safe from either side)
+    size_t available() const;
+
+    /// Total number of samples the ring can hold
+    size_t capacity() const;
+
+    /// Drop all unread samples (consumer side)
+    void clear();
+
+private:
+    std::vector<float> data_;
+    size_t mask_;
+    std::atomic<size_t> head_{0};  // Next write position (owned by producer)
+    std::atomic<size_t> tail_{0};  // Next read position (owned by consumer)
+};
+
+#endif // AUDIO_RING_BUFFER_H
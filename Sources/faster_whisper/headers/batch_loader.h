@@ -0,0 +1,78 @@
+//
+// batch_loader.h
+// SwiftFasterWhisper
+//
+// Created by Amr Aboelela on 10/18/2026.
+//
+
+#ifndef BATCH_LOADER_H
+#define BATCH_LOADER_H
+
+#include "feature_extractor.h"
+#include "time_compression.h"
+#include <condition_variable>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// One file prepared by BatchLoader
+struct LoadedAudio {
+    size_t index = 0;                           // Position in the path list
+    std::string path;
+    float duration = 0.0f;                      // Seconds of 16kHz mono audio
+    std::vector<std::vector<float>> features;   // Mel features of the whole file
+    whisper::TimeMap time_map;                  // Maps feature time back to the file (factor 1 if not compressed)
+    std::string error;                          // Non-empty if the file could not be loaded
+};
+
+/// BatchLoader reads, decodes, resamples and extracts features for upcoming files on worker threads
+/// while the caller transcribes the current one, so I/O and DSP overlap with inference
+/// Files are returned in order; at most `prefetch` prepared files wait in memory at a time
+class BatchLoader {
+public:
+    /// Constructor (workers start immediately)
+    /// @param paths Audio files (WAV or FLAC) in the order they will be returned
+    /// @param extractor Feature extractor of the model that will transcribe the files
+    /// @param prefetch Maximum number of prepared files waiting to be returned
+    /// @param workers Number of loader threads
+    /// @param time_compression Speed-up applied to the audio before feature extraction (1 for none)
+    BatchLoader(std::vector<std::string> paths,
+                FeatureExtractor& extractor,
+                size_t prefetch = 2,
+                size_t workers = 2,
+                float time_compression = 1.0f);
+
+    /// Stops the workers (files being loaded are finished and discarded)
+    ~BatchLoader();
+
+    BatchLoader(const BatchLoader&) = delete;
+    BatchLoader& operator=(const BatchLoader&) = delete;
+
+    /// Get the next file, waiting for its worker if it is not ready yet
+    /// @param loaded Output file (check error before using its features)
+    /// @return false when every file has been returned
+    bool next(LoadedAudio& loaded);
+
+private:
+    void worker_loop();
+    LoadedAudio load(size_t index) const;
+
+    std::vector<std::string> paths_;
+    FeatureExtractor& extractor_;
+    size_t prefetch_;
+    float time_compression_;
+
+    std::mutex mutex_;
+    std::condition_variable ready_;    // A file finished loading
+    std::condition_variable space_;    // A file was returned, or stopping
+    std::map<size_t, LoadedAudio> loaded_;
+    size_t next_to_claim_ = 0;         // Next index a worker will load
+    size_t next_to_return_ = 0;        // Next index next() returns
+    bool stopping_ = false;
+    std::vector<std::thread> workers_;
+};
+
+#endif // BATCH_LOADER_H
@@ -0,0 +1,168 @@
+//
+// byte_stream.h
+// SwiftFasterWhisper
+//
+// Created by Amr Aboelela on 10/18/2026.
+//
+
+#ifndef BYTE_STREAM_H
+#define BYTE_STREAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/// Little-endian writer for versioned binary blobs (checkpoints, snapshots)
+class ByteWriter {
+public:
+    void u8(uint8_t value) {
+        bytes_.push_back(value);
+    }
+
+    void u16(uint16_t value) {
+        bytes_.push_back(static_cast<uint8_t>(value));
+        bytes_.push_back(static_cast<uint8_t>(value >> 8));
+    }
+
+    void u32(uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            bytes_.push_back(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    void u64(uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            bytes_.push_back(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    void i32(int32_t value) {
+        u32(static_cast<uint32_t>(value));
+    }
+
+    void f32(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        u32(bits);
+    }
+
+    void f64(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        u64(bits);
+    }
+
+    void string(const std::string& value) {
+        u32(static_cast<uint32_t>(value.size()));
+        bytes_.insert(bytes_.end(), value.begin(), value.end());
+    }
+
+    void ints(const std::vector<int>& values) {
+        u32(static_cast<uint32_t>(values.size()));
+        for (int value : values) {
+            i32(value);
+        }
+    }
+
+    std::vector<uint8_t>& bytes() {
+        return bytes_;
+    }
+
+private:
+    std::vector<uint8_t> bytes_;
+};
+
+/// Little-endian reader, throws std::runtime_error("<name> is truncated") on truncated input
+class ByteReader {
+public:
+    ByteReader(const uint8_t* data, size_t size, const char* name) : data_(data), size_(size), name_(name) {}
+
+    uint8_t u8() {
+        require(1);
+        return data_[pos_++];
+    }
+
+    uint16_t u16() {
+        require(2);
+        uint16_t value = static_cast<uint16_t>(data_[pos_] | (data_[pos_ + 1] << 8));
+        pos_ += 2;
+        return value;
+    }
+
+    uint32_t u32() {
+        require(4);
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i) {
+            value |= static_cast<uint32_t>(data_[pos_++]) << (8 * i);
+        }
+        return value;
+    }
+
+    uint64_t u64() {
+        require(8);
+        uint64_t value = 0;
+        for (int i = 0; i < 8; ++i) {
+            value |= static_cast<uint64_t>(data_[pos_++]) << (8 * i);
+        }
+        return value;
+    }
+
+    int32_t i32() {
+        return static_cast<int32_t>(u32());
+    }
+
+    float f32() {
+        uint32_t bits = u32();
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    double f64() {
+        uint64_t bits = u64();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    std::string string() {
+        uint32_t length = u32();
+        require(length);
+        std::string value(reinterpret_cast<const char*>(data_ + pos_), length);
+        pos_ += length;
+        return value;
+    }
+
+    std::vector<int> ints() {
+        uint32_t count = u32();
+        require(static_cast<size_t>(count) * 4);
+        std::vector<int> values(count);
+        for (auto& value : values) {
+            value = i32();
+        }
+        return values;
+    }
+
+    /// Number of bytes not read yet
+    size_t remaining() const {
+        return size_ - pos_;
+    }
+
+    /// Fail unless the next bytes are available (e.g. before reserving a counted array)
+    void require(size_t bytes) const {
+        if (bytes > size_ - pos_) {
+            throw std::runtime_error(std::string(name_) + " is truncated");
+        }
+    }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    const char* name_;
+    size_t pos_ = 0;
+};
+
+#endif // BYTE_STREAM_H
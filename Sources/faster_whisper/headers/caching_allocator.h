@@ -0,0 +1,69 @@
+//
+// caching_allocator.h
+// SwiftFasterWhisper
+//
+// Created by Amr Aboelela on 10/18/2026.
+//
+
+#ifndef CACHING_ALLOCATOR_H
+#define CACHING_ALLOCATOR_H
+
+#include <ctranslate2/allocator.h>
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/// CachingAllocator keeps freed blocks in per-size free lists instead of returning them to the system
+/// Whisper tensor shapes are fixed per window (batch x 80 x 3000 encoder input), so after the first
+/// window every allocation is served from the cache
+class CachingAllocator : public ctranslate2::Allocator {
+public:
+    /// Allocation counters and memory footprint
+    struct Stats {
+        size_t hits = 0;                // Allocations served from the cache
+        size_t misses = 0;              // Allocations that had to reach the system allocator
+        size_t bytes_reserved = 0;      // Bytes held by the allocator (cached + in use)
+        size_t bytes_in_use = 0;        // Bytes currently handed out
+        size_t peak_bytes_in_use = 0;   // High-water mark of bytes_in_use
+    };
+
+    /// Constructor
+    /// @param alignment Block alignment in bytes (default: 64, same as CTranslate2)
+    explicit CachingAllocator(size_t alignment = 64);
+    ~CachingAllocator() override;
+
+    CachingAllocator(const CachingAllocator&) = delete;
+    CachingAllocator& operator=(const CachingAllocator&) = delete;
+
+    using ctranslate2::Allocator::allocate;
+    using ctranslate2::Allocator::free;
+
+    void* allocate(size_t size, int device_index) override;
+    void free(void* ptr, int device_index) override;
+
+    /// Release all cached (unused) blocks back to the system
+    void clear_cache() override;
+
+    /// Pre-allocate blocks so the first window does not pay for them
+    /// @param size Block size in bytes
+    /// @param count Number of blocks to keep cached for this size
+    void reserve(size_t size, size_t count = 1);
+
+    /// Get a snapshot of the allocator counters
+    Stats stats() const;
+
+private:
+    size_t bucket_size(size_t size) const;
+    void* system_allocate(size_t bytes);
+
+    size_t alignment_;
+    mutable std::mutex mutex_;
+    std::unordered_map<size_t, std::vector<void*>> free_blocks_;  // Bucket size -> cached blocks
+    std::unordered_map<void*, size_t> block_sizes_;               // Live block -> bucket size
+    Stats stats_;
+
+    static constexpr size_t BUCKET_GRANULARITY = 4096;  // Round block sizes up to a page
+};
+
+#endif // CACHING_ALLOCATOR_H
@@ -10,6 +10,8 @@
 
 #include <vector>
 #include <complex>
+#include <memory>
+#include "feature_plan.h"
 
 // A simple 2D vector to represent a matrix, analogous to a NumPy array.
 using Matrix = std::vector<std::vector<float>>;
@@ -56,6 +58,7 @@ public:
   float time_per_frame_;
   int sampling_rate_;
   Matrix mel_filters;
+  std::shared_ptr<const whisper::FeaturePlan> plan_;  // Shared window, filterbank and FFT tables
 
   // Static helper methods, equivalent to Python's @staticmethod
   static Matrix get_mel_filters(int sr, int n_fft, int n_mels);
@@ -0,0 +1,100 @@
+//
+// feature_stream.h
+// SwiftFasterWhisper
+//
+// Created by Amr Aboelela on 10/18/2026.
+//
+
+#ifndef FEATURE_STREAM_H
+#define FEATURE_STREAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class ByteReader;
+
+/// Sample format of the mel frames in a feature packet
+enum class FeatureEncoding : uint8_t {
+    Float16 = 0,    // IEEE half precision, 2 bytes per value
+    Int8 = 1        // 8-bit codes with a per-packet offset and scale, 1 byte per value
+};
+
+/// Log-mel features of one streaming window, reassembled from packets
+struct FeatureWindow {
+    uint32_t window = 0;                        // Window number (counts up from 0 per stream)
+    uint32_t window_samples = 0;                // 16kHz samples the features were extracted from
+    std::vector<std::vector<float>> features;   // [n_mels][frames], as FeatureExtractor::extract returns
+};
+
+/// Compact wire format for streaming log-mel features from a capture device to a server
+///
+/// A window's frames are cut into packets of at most frames_per_packet frames. Each packet is a
+/// 24-byte little-endian header followed by its frames, frame by frame:
+///
+///     magic "FWMF" | version u8 | encoding u8 | flags u8 (bit 0: first, bit 1: last packet of the window) | reserved u8
+///     n_mels u16 | frame_count u16 | sequence u32 | window u32 | window_samples u32
+///     [Int8 only: offset f32 | scale f32]  frame_count x n_mels values
+///
+/// Sequence numbers count packets across windows, so the receiver can tell a lost packet from a
+/// window boundary. Int8 uses 1/8 of the bandwidth of 16kHz float PCM at 100 frames per second
+namespace feature_stream {
+    constexpr size_t HEADER_SIZE = 24;
+    constexpr size_t DEFAULT_FRAMES_PER_PACKET = 100;  // One second of frames
+}
+
+/// Edge side: turns feature windows into packets
+class FeatureStreamEncoder {
+public:
+    /// Constructor
+    /// @param encoding Sample format of the packets
+    /// @param frames_per_packet Maximum frames per packet (at most 65535)
+    explicit FeatureStreamEncoder(FeatureEncoding encoding = FeatureEncoding::Int8,
+                                  size_t frames_per_packet = feature_stream::DEFAULT_FRAMES_PER_PACKET);
+
+    /// Encode one window
+    /// @param features [n_mels][frames] from FeatureExtractor::extract
+    /// @param window_samples Number of 16kHz samples the features were extracted from
+    /// @return The window's packets, back to back
+    std::vector<uint8_t> encode_window(const std::vector<std::vector<float>>& features, size_t window_samples);
+
+private:
+    FeatureEncoding encoding_;
+    size_t frames_per_packet_;
+    uint32_t next_sequence_ = 0;
+    uint32_t next_window_ = 0;
+};
+
+/// Server side: reassembles windows from packets
+/// A window with a missing packet is dropped whole (its frames would be misaligned), and decoding
+/// resumes with the next window
+class FeatureStreamDecoder {
+public:
+    /// Feed received bytes (one or more whole packets)
+    /// @param data Packet bytes
+    /// @param size Number of bytes
+    /// @param completed Output, windows whose last packet arrived (windows completed before a malformed
+    ///                  packet are kept; the window it belonged to is dropped)
+    /// @throws std::runtime_error if a packet is malformed (bad magic, version, or truncated)
+    void push(const uint8_t* data, size_t size, std::vector<FeatureWindow>& completed);
+
+    /// @return Number of windows dropped because of missing packets
+    size_t dropped_windows() const { return dropped_windows_; }
+
+private:
+    /// Decode the packet at the reader's position
+    void read_packet(ByteReader& reader, std::vector<FeatureWindow>& completed);
+
+    /// Give up on the window being reassembled and skip its remaining packets
+    void drop_pending();
+
+    FeatureWindow pending_;                         // Window being reassembled
+    bool has_pending_ = false;
+    bool skipping_ = false;                         // Discarding the rest of a broken window
+    uint32_t skipped_window_ = 0;
+    bool has_sequence_ = false;
+    uint32_t expected_sequence_ = 0;
+    size_t dropped_windows_ = 0;
+};
+
+#endif // FEATURE_STREAM_H
@@ -0,0 +1,110 @@
+//
+// segment_iterator.h
+// SwiftFasterWhisper
+//
+// Created by Amr Aboelela on 10/18/2026.
+//
+
+#ifndef SEGMENT_ITERATOR_H
+#define SEGMENT_ITERATOR_H
+
+#include "transcribe.h"
+#include "transcription_checkpoint.h"
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+/// SegmentIterator yields the segments of a long transcription as each seek window is decoded
+/// (like faster-whisper's segment generator), instead of after the whole file
+/// Created by WhisperModel::transcribe_iter; the model must outlive the iterator
+class SegmentIterator {
+public:
+    enum class Status {
+        Running,            // More segments may follow
+        Finished,           // Whole audio decoded
+        Cancelled,          // cancel() was called
+        BudgetExceeded      // Wall-clock budget ran out before the audio was fully decoded
+    };
+
+    /// Constructor
+    /// @param model Model used to decode each window
+    /// @param features Mel features of the whole audio
+    /// @param tokenizer Tokenizer for the resolved language and task
+    /// @param task "transcribe" or "translate" (recorded in checkpoints)
+    /// @param options Transcription options
+    /// @param info Language, duration and options reported for this transcription
+    /// @param audio_crc TranscriptionCheckpoint::audio_digest of the audio (recorded in checkpoints)
+    /// @param deadline Stop decoding new windows after this point (std::nullopt for no limit)
+    SegmentIterator(WhisperModel& model,
+                    std::vector<std::vector<float>> features,
+                    std::unique_ptr<Tokenizer> tokenizer,
+                    const std::string& task,
+                    const TranscriptionOptions& options,
+                    const TranscriptionInfo& info,
+                    uint32_t audio_crc,
+                    std::optional<std::chrono::steady_clock::time_point> deadline);
+
+    SegmentIterator(const SegmentIterator&) = delete;
+    SegmentIterator& operator=(const SegmentIterator&) = delete;
+
+    /// Get the next segment, decoding windows until one produces text
+    /// @param segment Output segment
+    /// @return false when there are no more segments (see status() for why)
+    bool next(Segment& segment);
+
+    /// Stop decoding before the next window (safe to call from any thread)
+    void cancel();
+
+    /// @return Why iteration stopped, or Running
+    Status status() const;
+
+    /// @return Seconds of audio decoded so far (safe to call from any thread)
+    float progress() const;
+
+    const TranscriptionInfo& info() const;
+
+    /// Snapshot the transcription so it can be resumed elsewhere (call between next() calls)
+    /// @return Checkpoint at the last decoded window
+    TranscriptionCheckpoint checkpoint() const;
+
+    /// Call handler with a checkpoint after each window that moves the decoded position
+    /// at least interval_seconds of audio past the previous checkpoint
+    /// @param interval_seconds Seconds of audio between checkpoints (0 = after every window)
+    /// @param handler Receives the checkpoint (on the thread calling next())
+    void set_checkpoint_handler(float interval_seconds, std::function<void(const TranscriptionCheckpoint&)> handler);
+
+    /// Continue from a checkpoint instead of the beginning of the audio
+    /// Segments that were pending in the checkpoint are returned first
+    /// @param checkpoint Checkpoint taken on the same audio
+    /// @throws std::runtime_error if the checkpoint belongs to different audio (length or digest differ)
+    void restore(const TranscriptionCheckpoint& checkpoint);
+
+private:
+    // Make the decoded position visible to progress() on other threads
+    void publish_progress();
+
+    WhisperModel& model_;
+    std::vector<std::vector<float>> features_;
+    std::unique_ptr<Tokenizer> tokenizer_;
+    std::string task_;
+    TranscriptionOptions options_;
+    TranscriptionInfo info_;
+    uint32_t audio_crc_;
+    std::optional<std::chrono::steady_clock::time_point> deadline_;
+
+    SegmentGenerationState state_;
+    std::deque<Segment> pending_;       // Decoded segments not handed out yet
+    std::atomic<bool> cancelled_{false};
+    std::atomic<int> published_seek_{0};  // state_.seek for progress(), content frames once finished
+    Status status_ = Status::Running;
+
+    std::function<void(const TranscriptionCheckpoint&)> checkpoint_handler_;
+    float checkpoint_interval_ = 0.0f;
+    float last_checkpoint_ = 0.0f;      // progress() at the previous checkpoint
+};
+
+#endif // SEGMENT_ITERATOR_H
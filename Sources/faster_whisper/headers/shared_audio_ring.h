@@ -0,0 +1,124 @@
+//
+// shared_audio_ring.h
+// SwiftFasterWhisper
+//
+// Created by Amr Aboelela on 10/18/2026.
+//
+
+#ifndef SHARED_AUDIO_RING_H
+#define SHARED_AUDIO_RING_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/// SharedAudioRing is a single-producer/single-consumer ring of float samples in a named POSIX
+/// shared-memory region, so a capture service in another process can feed a streaming session
+/// The inference process creates the region; the capture process opens it by name and writes
+/// Writes are plain stores into the mapping: no serialization and no syscall per chunk
+/// On Linux, an eventfd doorbell is signalled only when the ring crosses the consumer's window threshold
+class SharedAudioRing {
+public:
+    /// Create and map a new region (consumer side); the name is unlinked again on destruction
+    /// @param name Shared-memory name, starting with '/' (at most 31 characters on Apple platforms)
+    /// @param capacity Minimum number of samples the ring can hold (rounded up to a power of two)
+    /// @throws std::runtime_error if the region cannot be created
+    static std::unique_ptr<SharedAudioRing> create(const std::string& name, size_t capacity);
+
+    /// Map an existing region (producer side)
+    /// @param name Name passed to create()
+    /// @param doorbell_fd The creator's doorbell_fd(), received over a UNIX socket (-1 for none)
+    /// @throws std::runtime_error if the region does not exist or is not a ring
+    static std::unique_ptr<SharedAudioRing> open(const std::string& name, int doorbell_fd = -1);
+
+    ~SharedAudioRing();
+
+    SharedAudioRing(const SharedAudioRing&) = delete;
+    SharedAudioRing& operator=(const SharedAudioRing&) = delete;
+
+    /// Write samples (producer side)
+    /// All-or-nothing: if the ring cannot hold every sample, nothing is written
+    /// @return true if the samples were written
+    bool write(const float* samples, size_t count);
+
+    /// Hand every readable sample to a callback and release it (consumer side)
+    /// The callback is invoked with at most two contiguous spans of the mapping, oldest first
+    /// @param consume Callback taking (const float* samples, size_t count)
+    /// @return Number of samples consumed
+    template <typename Consumer>
+    size_t consume_all(Consumer&& consume) {
+        drain_doorbell();
+
+        const uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+        const uint64_t head = header_->head.load(std::memory_order_acquire);
+        const size_t count = static_cast<size_t>(head - tail);
+        if (count == 0) {
+            return 0;
+        }
+
+        const size_t start = static_cast<size_t>(tail) & mask_;
+        const size_t first = std::min(count, capacity_ - start);
+        consume(data_ + start, first);
+        if (first < count) {
+            consume(data_, count - first);
+        }
+
+        header_->tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    /// Ring the doorbell once at least this many samples are waiting (consumer side)
+    /// @param samples Samples still missing for the next window (0 disables the doorbell)
+    void set_notify_threshold(size_t samples);
+
+    /// Number of samples waiting to be consumed (safe from either side)
+    size_t available() const;
+
+    /// Total number of samples the ring can hold
+    size_t capacity() const;
+
+    /// Drop all unread samples (consumer side)
+    void clear();
+
+    /// Consumer has gone away; further writes fail (producer side)
+    bool is_closed() const;
+
+    /// File descriptor that becomes readable when a window is due (-1 if unsupported)
+    /// Pass it to the capture process with SCM_RIGHTS
+    int doorbell_fd() const;
+
+private:
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t capacity;
+        std::atomic<uint64_t> notify_threshold;
+        std::atomic<uint32_t> closed;
+        alignas(64) std::atomic<uint64_t> head;  // Next write position (owned by producer)
+        alignas(64) std::atomic<uint64_t> tail;  // Next read position (owned by consumer)
+    };
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared ring needs address-free 64-bit atomics");
+
+    static constexpr uint32_t MAGIC = 0x52535746;  // "FWSR"
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t DATA_OFFSET = (sizeof(Header) + 63) / 64 * 64;
+
+    SharedAudioRing(void* mapping, size_t mapping_size, const std::string& name, bool owner, int doorbell_fd);
+
+    void drain_doorbell();
+
+    void* mapping_;
+    size_t mapping_size_;
+    Header* header_;
+    float* data_;
+    size_t capacity_;
+    size_t mask_;
+    std::string name_;
+    bool owner_;        // Created the region (consumer): unlinks it and closes the doorbell
+    int doorbell_fd_;
+};
+
+#endif // SHARED_AUDIO_RING_H
@@ -8,30 +8,95 @@
 #ifndef STREAMING_BUFFER_H
 #define STREAMING_BUFFER_H
 
+#include "audio_ring_buffer.h"
+#include "shared_audio_ring.h"
+#include <atomic>
+#include <memory>
 #include <vector>
 #include <cstddef>
 
+/// Window geometry of one streaming session, in samples at the session's sample rate
+/// Defaults: 4.2s window, 4s hop, 0.2s overlap, catch-up windows up to 30s
+struct StreamingGeometry {
+    size_t sample_rate = 16000;             // Rate of the audio written to the session
+    size_t window_samples = 67200;          // Audio decoded per window
+    size_t hop_samples = 64000;             // Trimmed after each window; the rest overlaps the next one
+    size_t max_window_samples = 480000;     // Largest catch-up window
+    bool auto_size = false;                 // Grow the window when decoding is too slow to keep up
+
+    /// Build a geometry from durations in seconds
+    /// @param hop_seconds Advance per window (<= 0 keeps a 0.2s overlap)
+    /// @param max_window_seconds Largest catch-up window (<= 0 uses max_input_seconds)
+    /// @param max_input_seconds Longest audio the model takes in one pass (30s for Whisper)
+    static StreamingGeometry from_seconds(size_t sample_rate,
+                                          float window_seconds,
+                                          float hop_seconds,
+                                          float max_window_seconds,
+                                          bool auto_size,
+                                          float max_input_seconds = 30.0f);
+
+    /// Samples re-decoded at the start of the next window
+    size_t overlap_samples() const { return window_samples - hop_samples; }
+
+    /// Check the geometry against the model's input length
+    /// @throws std::invalid_argument describing the first violated limit
+    void validate(float max_input_seconds = 30.0f) const;
+};
+
 /// StreamingBuffer manages a rolling audio buffer for real-time transcription
-/// Supports adding audio chunks and maintaining a sliding window (4.2s window, 4s shift, 0.2s overlap)
+/// Supports adding audio chunks and maintaining a sliding window (by default 4.2s window, 4s hop, 0.2s overlap)
+/// Capture threads write into a lock-free ring (write), the decoding thread drains it (commit_pending)
+/// A capture service in another process can write into an attached SharedAudioRing instead
+/// When decoding falls behind, the next window grows to cover the whole backlog (up to 30s), so one
+/// encoder pass replaces several 4.2s ones (a 4.2s window is padded to 30s by the encoder anyway)
+/// With auto_size, the window also grows (never below the configured size) until its hop covers the
+/// measured decode time, trading latency for keeping up on slow devices
 class StreamingBuffer {
 public:
     /// Constructor
-    /// @param sample_rate Audio sample rate in Hz (default: 16000)
-    explicit StreamingBuffer(size_t sample_rate = 16000);
+    /// @param geometry Window geometry of the session (validate it first)
+    explicit StreamingBuffer(const StreamingGeometry& geometry = StreamingGeometry());
 
     /// Add an audio chunk to the buffer
     /// @param chunk Audio samples to add
     void add_chunk(const std::vector<float> &chunk);
 
-    /// Get a 4-second window from the current position for transcription
-    /// @return Vector of audio samples (4 seconds worth)
+    /// Add raw samples to the buffer (decoding thread)
+    /// @param samples Audio samples to add
+    /// @param count Number of samples
+    void add_samples(const float* samples, size_t count);
+
+    /// Write samples into the ingest ring (capture thread, lock-free, no allocation)
+    /// @param samples Audio samples to copy
+    /// @param count Number of samples
+    /// @return false if the ring is full and the samples were dropped
+    bool write(const float* samples, size_t count);
+
+    /// Also drain a shared-memory ring written by another process (call before writing starts)
+    /// @param ring Ring created by this process with SharedAudioRing::create
+    void attach_shared_ring(std::unique_ptr<SharedAudioRing> ring);
+
+    /// @return The attached shared-memory ring, or nullptr
+    const SharedAudioRing* shared_ring() const;
+
+    /// Move samples written by the capture thread (or process) into the buffer (decoding thread)
+    /// @return Number of samples committed
+    size_t commit_pending();
+
+    /// Check if a full window is available, counting samples still in the ingest ring
+    /// Safe to call from the capture thread
+    /// @return true if the decoding thread has a window to transcribe
+    bool is_window_due() const;
+
+    /// Get the next window from the current position for transcription
+    /// @return Vector of audio samples (window_size() worth)
     std::vector<float> get_window() const;
 
-    /// Check if buffer has enough audio for a 4-second window
-    /// @return true if buffer has at least 4 seconds from current window position
+    /// Check if buffer has enough audio for a full window
+    /// @return true if buffer has at least one window from current window position
     bool is_ready_to_decode() const;
 
-    /// Slide the window forward by 3.5 seconds
+    /// Slide the window forward by one hop
     void slide_window();
 
     /// Trim samples from the beginning of the buffer after emitting a segment
@@ -54,13 +119,53 @@ public:
     /// @return Window start position in samples
     size_t window_position() const;
 
+    /// Get the size of the next window
+    /// @return One window of samples, or the whole backlog (up to the maximum window) when catching up
+    size_t window_size() const;
+
+    /// Get the number of samples to trim after decoding the next window
+    /// @return window_size() minus the overlap kept for the following window
+    size_t window_shift() const;
+
+    /// Get the current (non catch-up) window size, safe to call from any thread
+    /// @return The configured window, or larger once auto_size has grown it
+    size_t base_window_size() const;
+
+    /// Get the session's configured geometry
+    const StreamingGeometry& geometry() const;
+
+    /// Record how long the last window took to decode (decoding thread)
+    /// Updates the real-time factor and, with auto_size, the window size
+    /// @param seconds Wall-clock decode time
+    /// @param window_samples Size of the decoded window
+    void record_decode(double seconds, size_t window_samples);
+
+    /// Get the smoothed real-time factor (decode time / audio duration)
+    /// @return 0 until a window has been decoded
+    double real_time_factor() const;
+
+    /// Check if the next window is a catch-up window
+    /// @return true if at least two windows' worth of audio is waiting
+    bool is_catching_up() const;
+
 private:
+    friend struct StreamingSnapshot;
+
+    /// Publish the number of samples from the window position to the end of the buffer
+    void update_backlog();
+
     std::vector<float> buffer_;          // Accumulated audio buffer
-    size_t sample_rate_;                 // Audio sample rate (16000 Hz)
+    StreamingGeometry geometry_;         // Configured geometry (sample rate, sizes)
+    std::atomic<size_t> window_samples_; // Current window size (grows from geometry_ with auto_size)
+    double decode_seconds_ = 0.0;        // Smoothed decode time per window
+    double real_time_factor_ = 0.0;      // Smoothed decode time / window duration
     size_t window_start_;                // Current window start position (in samples)
+    AudioRingBuffer ring_;               // Samples written by the capture thread, not yet committed
+    std::atomic<size_t> backlog_{0};     // buffer_.size() - window_start_, readable from any thread
+    std::unique_ptr<SharedAudioRing> shared_ring_;  // Samples written by another process, if attached
 
-    static constexpr size_t WINDOW_SIZE_SAMPLES = 67200;  // 4.2 seconds at 16kHz
-    static constexpr size_t SLIDE_SIZE_SAMPLES = 56000;   // 3.5 seconds at 16kHz (deprecated)
+    static constexpr double DECODE_SMOOTHING = 0.3;       // Weight of the newest decode time
+    static constexpr double AUTO_SIZE_HEADROOM = 1.25;    // Hop covers this multiple of the decode time
 };
 
 #endif // STREAMING_BUFFER_H
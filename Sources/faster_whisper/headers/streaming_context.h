@@ -0,0 +1,71 @@
+//
+// streaming_context.h
+// SwiftFasterWhisper
+//
+// Created by Amr Aboelela on 10/18/2026.
+//
+
+#ifndef STREAMING_CONTEXT_H
+#define STREAMING_CONTEXT_H
+
+#include "transcribe.h"
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+/// StreamingContext carries decoder state from one streaming window to the next
+/// Each window is decoded with the previous windows' tokens as its prompt, and the tokenizer
+/// and options resolved on the first window are reused instead of being rebuilt per window
+class StreamingContext {
+public:
+    /// When the token history is dropped
+    struct ResetPolicy {
+        size_t max_history_tokens = 223;    // max_length / 2 - 1, the most get_prompt will use
+        float reset_on_temperature = 0.5f;  // Drop the history after a window needed a fallback above this
+        size_t max_silent_windows = 2;      // Drop the history after this many windows without accepted text
+    };
+
+    /// Constructor
+    /// @param language Language code, or std::nullopt to detect it on the first confident window
+    /// @param task "transcribe" or "translate"
+    StreamingContext(const std::optional<std::string>& language, const std::string& task);
+
+    /// Constructor with a custom reset policy
+    /// @param policy Token history bounds and reset rules
+    StreamingContext(const std::optional<std::string>& language, const std::string& task, const ResetPolicy& policy);
+
+    /// Record the outcome of a window
+    /// @param decoded_segments Every segment the decoder produced for the window
+    /// @param accepted_segments The segments that were actually emitted (after hallucination filtering)
+    void update(const std::vector<Segment>& decoded_segments, const std::vector<Segment>& accepted_segments);
+
+    /// Drop the token history (tokenizer and options are kept)
+    void reset();
+
+    /// Tokens to condition the next window on
+    const std::vector<int>& history() const;
+
+    const std::optional<std::string>& language() const;
+    const std::string& task() const;
+
+private:
+    friend class WhisperModel;
+    friend struct StreamingSnapshot;
+
+    std::optional<std::string> language_;
+    std::string task_;
+    ResetPolicy policy_;
+
+    std::vector<int> history_;
+    size_t silent_windows_ = 0;
+
+    // Resolved lazily by WhisperModel::transcribe_streaming
+    std::unique_ptr<Tokenizer> tokenizer_;
+    std::optional<TranscriptionOptions> options_;
+    std::string detected_language_;
+    float language_probability_ = 0.0f;
+    bool language_resolved_ = false;    // detected_language_ came from a snapshot; build the tokenizer without detecting
+};
+
+#endif // STREAMING_CONTEXT_H
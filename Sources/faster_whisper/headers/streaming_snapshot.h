@@ -0,0 +1,64 @@
+//
+// streaming_snapshot.h
+// SwiftFasterWhisper
+//
+// Created by Amr Aboelela on 10/18/2026.
+//
+
+#ifndef STREAMING_SNAPSHOT_H
+#define STREAMING_SNAPSHOT_H
+
+#include "streaming_buffer.h"
+#include "streaming_context.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+/// StreamingSnapshot captures a live streaming session so it can continue in another process or on
+/// another host with the same model (e.g. when draining a busy inference node)
+/// It holds everything the next window depends on: the audio not trimmed yet, the window geometry and
+/// auto-sized window, the decode statistics, and the decoding context (language, task, prompt history)
+/// Windows decoded before the snapshot are not decoded again, and no audio between them is lost
+struct StreamingSnapshot {
+    // Buffer
+    StreamingGeometry geometry;
+    size_t window_samples = 0;              // Current window size (auto-sized windows keep their size)
+    double decode_seconds = 0.0;            // Smoothed decode time per window
+    double real_time_factor = 0.0;
+    std::vector<float> audio;               // From the window position on, at geometry.sample_rate
+
+    // Decoding context
+    std::optional<std::string> language;    // Requested language (std::nullopt to detect)
+    std::string task;
+    StreamingContext::ResetPolicy policy;
+    std::vector<int> history;               // Prompt tokens for the next window
+    size_t silent_windows = 0;
+    std::string detected_language;          // Empty until the session language has been resolved
+    float language_probability = 0.0f;
+
+    /// Capture a session (decoding thread; commits samples still in the ingest rings first)
+    /// An attached shared-memory ring is drained but not carried over
+    static StreamingSnapshot capture(StreamingBuffer& buffer, const StreamingContext& context);
+
+    /// Rebuild the session's buffer
+    std::unique_ptr<StreamingBuffer> restore_buffer() const;
+
+    /// Rebuild the session's decoding context (a resolved language is not detected again)
+    std::unique_ptr<StreamingContext> restore_context() const;
+
+    /// Encode to a compact binary blob (versioned, CRC-checked; audio is stored as 16-bit PCM)
+    /// @return Snapshot bytes
+    std::vector<uint8_t> serialize() const;
+
+    /// Decode a blob produced by serialize()
+    /// @param data Snapshot bytes
+    /// @param size Number of bytes
+    /// @return Decoded snapshot
+    /// @throws std::runtime_error if the blob is truncated, corrupt or from an unknown version
+    static StreamingSnapshot deserialize(const uint8_t* data, size_t size);
+};
+
+#endif // STREAMING_SNAPSHOT_H
@@ -2,6 +2,7 @@
 #define WHISPER_MODEL_H
 
 #include "feature_extractor.h"
+#include "caching_allocator.h"
 
 #include <ctranslate2/models/whisper.h>
 #include "tokenizer.h"
@@ -11,6 +12,12 @@
 #include <optional>
 #include <memory>
 #include <variant>
+#include <functional>
+#include <atomic>
+
+class StreamingContext;
+class SegmentIterator;
+struct TranscriptionCheckpoint;
 
 struct Word {
   float start;
@@ -94,6 +101,10 @@ struct TranscriptionOptions {
   std::string append_punctuations;
   bool multilingual;
   std::optional<int> max_new_tokens;
+  // Attempts still generating after this many tokens per second of window (plus slack) are cut off
+  // and treated as failed, so the next temperature starts without decoding a repetition loop to max_length
+  // Unset (the default) means no budget; see WhisperModel::set_token_budget
+  std::optional<float> max_tokens_per_second;
 
   // clip_timestamps can be string (comma-separated) or vector<float>
   std::variant<std::string, std::vector<float>> clip_timestamps;
@@ -110,6 +121,64 @@ struct TranscriptionInfo {
   TranscriptionOptions transcription_options;
 };
 
+// Progressive transcription: a fast draft pass runs ahead of the accurate pass, which
+// replaces it window by window
+enum class ProgressivePass {
+  Draft,   // Greedy decoding (or a smaller model), no fallback, no prompt history
+  Final    // Configured model and options; replaces every draft segment in [start, end)
+};
+
+struct ProgressiveUpdate {
+  ProgressivePass pass;
+  float start;                    // Time range decoded by this window, in seconds
+  float end;
+  std::vector<Segment> segments;  // Segments of this window (may be empty for silence)
+};
+
+// Result of one file of WhisperModel::transcribe_files
+struct FileTranscription {
+  size_t index = 0;                 // Position in the path list
+  std::string path;
+  std::vector<Segment> segments;
+  TranscriptionInfo info;
+  std::string error;                // Non-empty if the file could not be loaded or transcribed
+};
+
+// Encoder output of one decoded window, for reuse by downstream models (speaker, audio events)
+struct EncoderWindow {
+  size_t batch_index;                        // Row of output (the channel for transcribe_stereo, else 0)
+  float start;                               // Time range encoded by this window, in seconds
+  float end;
+  size_t content_positions;                  // Encoder positions covering audio; the rest encode padding
+  const ctranslate2::StorageView *output;    // [batch, positions, d_model], valid only during the handler call
+};
+
+// Known text for WhisperModel::align
+struct AlignmentRequest {
+  std::string text;
+  std::optional<float> start;  // Seconds; a timed text is aligned inside [start, end]
+  std::optional<float> end;    // Seconds; defaults to 30 seconds after start
+};
+
+// Timestamps of one aligned text
+struct AlignedSegment {
+  std::string text;
+  float start;
+  float end;
+  std::vector<Word> words;
+};
+
+// Position of generate_segments in the audio, carried from one seek window to the next
+struct SegmentGenerationState {
+  std::vector<std::pair<int, int>> seek_clips;  // [start, end) frame ranges to decode
+  size_t clip_idx = 0;
+  int seek = 0;                                 // Next frame to decode
+  int idx = 0;                                  // Id of the last emitted segment
+  std::vector<int> all_tokens;                  // Prompt history
+  int prompt_reset_since = 0;                   // Prompt uses all_tokens from this index on
+  bool finished = false;
+};
+
 class  WhisperModel {
 public:
   // C++ constructor to match the Python `__init__`.
@@ -131,11 +200,36 @@ public:
     const std::string &model_path,
     const std::optional<std::string> &preprocessor_bytes = std::nullopt
   );
+  // on_encoder_output, when set, is called with the encoder output of every decoded window before decoding
+  // starts; the output is the one decoding uses, so nothing is copied
   std::tuple<std::vector<Segment>, TranscriptionInfo> transcribe(
     const std::vector<float> &audio,
     const std::optional<std::string> &language = std::nullopt,
     bool multilingual = false,
-    const std::string &task = "transcribe"
+    const std::string &task = "transcribe",
+    const std::function<void(const EncoderWindow &)> &on_encoder_output = nullptr
+  );
+
+  // transcribe for features already extracted with this model's feature extractor
+  std::tuple<std::vector<Segment>, TranscriptionInfo> transcribe_features(
+    const std::vector<std::vector<float>> &features,
+    float duration,
+    const std::optional<std::string> &language = std::nullopt,
+    bool multilingual = false,
+    const std::string &task = "transcribe",
+    const std::function<void(const EncoderWindow &)> &on_encoder_output = nullptr
+  );
+
+  // Transcribe a list of files in order, reporting each through on_file as soon as it is done
+  // A pipelined loader reads, decodes and extracts features for the next prefetch files on worker
+  // threads while the current file is transcribed; returns the number of files transcribed
+  size_t transcribe_files(
+    const std::vector<std::string> &paths,
+    const std::function<void(const FileTranscription &)> &on_file,
+    const std::optional<std::string> &language = std::nullopt,
+    bool multilingual = false,
+    const std::string &task = "transcribe",
+    size_t prefetch = 2
   );
 
   // Translation (any language → English)
@@ -144,6 +238,76 @@ public:
     const std::optional<std::string> &source_language = std::nullopt
   );
 
+  // Transcribe the two channels of a stereo recording (e.g. agent / customer) as one batch of two
+  // Returns one segment list per channel, with timestamps on the shared timeline
+  std::tuple<std::vector<std::vector<Segment>>, TranscriptionInfo> transcribe_stereo(
+    const std::vector<float> &left,
+    const std::vector<float> &right,
+    const std::optional<std::string> &language = std::nullopt,
+    bool multilingual = false,
+    const std::string &task = "transcribe"
+  );
+
+  // Transcribe lazily: each call to SegmentIterator::next decodes one more seek window
+  // The iterator can be cancelled from any thread and stops once time_budget_seconds have elapsed
+  std::unique_ptr<SegmentIterator> transcribe_iter(
+    const std::vector<float> &audio,
+    const std::optional<std::string> &language = std::nullopt,
+    bool multilingual = false,
+    const std::string &task = "transcribe",
+    std::optional<double> time_budget_seconds = std::nullopt
+  );
+
+  // Two-pass transcription for user-facing uploads: a fast draft pass and the accurate pass report every
+  // window through on_update; each final window replaces the draft segments in its time range, and draft
+  // windows the final pass has already covered are not reported
+  // draft_model decodes the draft pass when given (e.g. a smaller model); otherwise this model decodes it greedily
+  // The passes run concurrently (the draft on its own thread) when the draft has a replica of its own: a
+  // separate draft_model, or num_workers > 1. With one replica the draft runs first, then the final pass
+  // on_update may be called from both threads, but never concurrently
+  // Returns the final segments
+  std::tuple<std::vector<Segment>, TranscriptionInfo> transcribe_progressive(
+    const std::vector<float> &audio,
+    const std::function<void(const ProgressiveUpdate &)> &on_update,
+    const std::optional<std::string> &language = std::nullopt,
+    bool multilingual = false,
+    const std::string &task = "transcribe",
+    WhisperModel *draft_model = nullptr
+  );
+
+  // Continue a transcribe_iter run from a checkpoint (same audio), yielding the segments it had not returned yet
+  std::unique_ptr<SegmentIterator> resume_iter(
+    const std::vector<float> &audio,
+    const TranscriptionCheckpoint &checkpoint,
+    std::optional<double> time_budget_seconds = std::nullopt
+  );
+
+  // Forced alignment: word and segment timestamps for texts already known (e.g. a script or a corrected
+  // transcript), from the encoder and the alignment heads only, without decoding
+  // Untimed texts are aligned together in one window that starts where the previous timed text ends
+  // (at most 30 seconds of audio); windows are encoded and aligned in batches
+  std::tuple<std::vector<AlignedSegment>, TranscriptionInfo> align(
+    const std::vector<float> &audio,
+    const std::vector<AlignmentRequest> &requests,
+    const std::optional<std::string> &language = std::nullopt,
+    const std::string &task = "transcribe"
+  );
+
+  // Transcribe one streaming window, prompted with the session's previous tokens
+  // The context's tokenizer and options are built on the first window and reused afterwards
+  std::tuple<std::vector<Segment>, TranscriptionInfo> transcribe_streaming(
+    const std::vector<float> &audio,
+    StreamingContext &context
+  );
+
+  // transcribe_streaming on features extracted elsewhere (e.g. on the capture device), for a window of
+  // `duration` seconds; features must have the model's number of mel bins
+  std::tuple<std::vector<Segment>, TranscriptionInfo> transcribe_streaming_features(
+    const std::vector<std::vector<float>> &features,
+    float duration,
+    StreamingContext &context
+  );
+
   std::tuple<std::vector<Segment>, int, bool> split_segments_by_timestamps(
     Tokenizer &tokenizer,
     const std::vector<int> &tokens,
@@ -153,17 +317,50 @@ public:
     int seek
   );
   std::vector<Segment> generate_segments(
+    const std::vector<std::vector<float>> &features,
+    Tokenizer &tokenizer,
+    const TranscriptionOptions &options,
+    const std::function<void(const EncoderWindow &)> &on_encoder_output = nullptr
+  );
+  // generate_segments one seek window at a time: begin_segments sets up the seek clips and
+  // initial prompt, generate_next_segments decodes the next window (state.finished when done)
+  SegmentGenerationState begin_segments(
     const std::vector<std::vector<float>> &features,
     Tokenizer &tokenizer,
     const TranscriptionOptions &options
   );
+  std::vector<Segment> generate_next_segments(
+    const std::vector<std::vector<float>> &features,
+    Tokenizer &tokenizer,
+    const TranscriptionOptions &options,
+    SegmentGenerationState &state,
+    const std::function<void(const EncoderWindow &)> &on_encoder_output = nullptr
+  );
+  // Decode several inputs of the same length in lockstep, one batched encode/generate per window
+  // (clip_timestamps and initial_prompt apply to every input, as in generate_segments)
+  std::vector<std::vector<Segment>> generate_segments_batch(
+    const std::vector<std::vector<std::vector<float>>> &features,
+    Tokenizer &tokenizer,
+    const TranscriptionOptions &options,
+    const std::function<void(const EncoderWindow &)> &on_encoder_output = nullptr
+  );
   ctranslate2::StorageView encode(const std::vector<std::vector<float>> &features);
+  ctranslate2::StorageView encode_batch(const std::vector<std::vector<std::vector<float>>> &batch);
   std::tuple<std::vector<int>, float, float, float>
   generate_with_fallback(
     const ctranslate2::StorageView &encoder_output,
     const std::vector<int> &prompt,
     Tokenizer &tokenizer,
-    const TranscriptionOptions &options
+    const TranscriptionOptions &options,
+    std::optional<float> segment_duration = std::nullopt
+  );
+  std::vector<std::tuple<std::vector<int>, float, float, float>>
+  generate_with_fallback_batch(
+    const ctranslate2::StorageView &encoder_output,
+    const std::vector<std::vector<int>> &prompts,
+    Tokenizer &tokenizer,
+    const TranscriptionOptions &options,
+    std::optional<float> segment_duration = std::nullopt
   );
   std::vector<int> get_prompt(
     Tokenizer &tokenizer,
@@ -188,6 +385,14 @@ public:
     int num_frames,
     int median_filter_width = 7
   );
+  // One num_frames per text, for a batch of windows with different content lengths
+  std::vector<std::vector<std::map<std::string, std::any>>> find_alignment(
+    Tokenizer &tokenizer,
+    const std::vector<std::vector<int>> &text_tokens,
+    const ctranslate2::StorageView &encoder_output,
+    const std::vector<int> &num_frames,
+    int median_filter_width = 7
+  );
   std::tuple<std::string, float, std::vector<std::pair<std::string, float>>> detect_language(
     const std::vector<float> *audio = nullptr,
     const std::vector<std::vector<float>> *features = nullptr,
@@ -200,7 +405,54 @@ public:
     Tokenizer& tokenizer
   );
 
+  // Mean of the encoder output over the window's content positions (one d_model vector)
+  static std::vector<float> pool_encoder_output(const EncoderWindow &window);
+
+  // Hit rate and footprint of the allocator backing encoder input tensors
+  CachingAllocator::Stats allocator_stats() const;
+
+  // Longest audio one encoder pass takes in (30s for Whisper); streaming windows must fit in it
+  float max_input_seconds() const;
+
+  // Throughput mode for bulk jobs: transcribe and transcribe_files speed speech up by factor (e.g. 1.25)
+  // without changing its pitch before extracting features, so each 30s window covers more audio
+  // Segment and word timestamps are mapped back to the original time; 1 turns it off
+  // Throws std::invalid_argument outside [1, 2]
+  void set_time_compression(float factor);
+  float time_compression() const { return time_compression_; }
+
+  // Cut off fallback attempts still generating after tokens_per_second per second of window (plus
+  // 32 tokens of slack) and move to the next temperature. Off (0) by default: a budget shortens
+  // legitimately dense windows too, so enable it for audio prone to repetition loops
+  // Throws std::invalid_argument if negative
+  void set_token_budget(float tokens_per_second);
+  float token_budget() const { return token_budget_.load(std::memory_order_relaxed); }
+
 private:
+  std::tuple<std::string, float, std::vector<std::pair<std::string, float>>> resolve_language(
+    const std::optional<std::string> &language,
+    const std::vector<std::vector<float>> &features
+  );
+  TranscriptionOptions default_transcription_options(bool multilingual, float duration) const;
+  TranscriptionOptions draft_transcription_options(float duration) const;
+  // Move state to the seek clip holding the next frame to decode; returns the clip's end frame
+  // (sets state.finished when every clip is done)
+  static int advance_seek_clip(SegmentGenerationState &state, int content_frames);
+  // Draft pass of transcribe_progressive on a separate draft model (its own features, language already resolved)
+  std::vector<Segment> draft_pass(
+    const std::vector<float> &audio,
+    const std::string &language,
+    const std::string &task,
+    const std::function<void(const ProgressiveUpdate &)> &on_update
+  );
+  std::vector<Segment> decode_pass(
+    const std::vector<std::vector<float>> &features,
+    Tokenizer &tokenizer,
+    const TranscriptionOptions &options,
+    ProgressivePass pass,
+    const std::function<void(const ProgressiveUpdate &)> &on_update
+  );
+
   std::shared_ptr<ctranslate2::models::Whisper> model;
   std::shared_ptr<tokenizers::Tokenizer> hf_tokenizer;
   FeatureExtractor feature_extractor;
@@ -213,6 +465,12 @@ private:
   double time_precision;
   int max_length;
 
+  float time_compression_ = 1.0f;  // set_time_compression
+  std::atomic<float> token_budget_{0.0f};  // set_token_budget, tokens per second (0 = no budget)
+
+  // Reused staging buffers for encoder input (batch x n_mels x 3000 floats)
+  CachingAllocator tensor_allocator_;
+
   // Time cursor for tracking emitted segments (prevents duplicates in streaming)
   float emitted_time_cursor = 0.0f;
 };
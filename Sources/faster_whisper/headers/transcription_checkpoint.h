@@ -0,0 +1,52 @@
+//
+// transcription_checkpoint.h
+// SwiftFasterWhisper
+//
+// Created by Amr Aboelela on 10/18/2026.
+//
+
+#ifndef TRANSCRIPTION_CHECKPOINT_H
+#define TRANSCRIPTION_CHECKPOINT_H
+
+#include "transcribe.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// TranscriptionCheckpoint captures a long transcription between two seek windows
+/// Resuming from it (WhisperModel::resume_iter) continues exactly where the interrupted run stopped:
+/// same seek position, same prompt history, same segment ids
+struct TranscriptionCheckpoint {
+    std::string language;
+    float language_probability = 0.0f;
+    std::string task;
+    bool multilingual = false;
+    float duration = 0.0f;                  // Seconds of audio
+    uint64_t content_frames = 0;            // Mel frames of the audio, to reject a different file on resume
+    uint32_t audio_crc = 0;                 // audio_digest of the samples, to reject different audio of the same length
+    SegmentGenerationState state;           // all_tokens holds only the tail a prompt can still use
+    std::vector<Segment> pending;           // Decoded but not handed out yet, returned first on resume
+
+    /// Encode to a compact binary blob (versioned, CRC-checked)
+    /// @return Checkpoint bytes
+    std::vector<uint8_t> serialize() const;
+
+    /// Decode a blob produced by serialize()
+    /// @param data Checkpoint bytes
+    /// @param size Number of bytes
+    /// @return Decoded checkpoint
+    /// @throws std::runtime_error if the blob is truncated, corrupt, from an unknown version,
+    ///         or its seek position or clips fall outside the audio
+    static TranscriptionCheckpoint deserialize(const uint8_t* data, size_t size);
+
+    /// CRC-32 of the audio samples a transcription runs on
+    /// @param audio Audio samples (16kHz mono float32)
+    /// @return Digest stored in checkpoints and checked on resume
+    static uint32_t audio_digest(const std::vector<float>& audio);
+
+    /// Prompt tokens worth keeping: get_prompt uses at most max_length / 2 - 1 of them
+    static constexpr size_t MAX_PROMPT_TOKENS = 223;
+};
+
+#endif // TRANSCRIPTION_CHECKPOINT_H
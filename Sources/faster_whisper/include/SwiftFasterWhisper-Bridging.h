@@ -20,6 +20,11 @@ typedef struct {
     unsigned long length;
 } FloatArray;
 
+typedef struct {
+    unsigned char* data;
+    unsigned long length;
+} ByteArray;
+
 typedef struct {
     float** data;
     unsigned long rows;
@@ -29,6 +34,18 @@ typedef struct {
 // Opaque pointer to WhisperModel (C++ class)
 typedef void* WhisperModelHandle;
 
+// Opaque pointer to the producer side of a shared-memory audio ring (C++ SharedAudioRing)
+typedef void* WhisperSharedRingHandle;
+
+// Opaque pointer to a lazy segment iterator (C++ SegmentIterator)
+typedef void* WhisperSegmentIteratorHandle;
+
+// Opaque pointer to the edge side of a feature stream (feature extractor + packet encoder)
+typedef void* WhisperFeatureEncoderHandle;
+
+// Opaque pointer to the server side of a feature stream (packet decoder + streaming context)
+typedef void* WhisperFeatureSessionHandle;
+
 // Transcription result structure
 typedef struct {
     char* text;              // Transcribed text
@@ -44,14 +61,143 @@ typedef struct {
     float duration;
 } TranscriptionResult;
 
+// Per-channel results of a stereo transcription (same timeline for both channels)
+typedef struct {
+    TranscriptionResult left;
+    TranscriptionResult right;
+} StereoTranscriptionResult;
+
+// Timestamps of one word from forced alignment
+typedef struct {
+    char* word;              // Word text, with its leading space
+    float start;             // Start time in seconds
+    float end;               // End time in seconds
+    float probability;       // Mean probability of the word's tokens
+} WordTiming;
+
+// One aligned text with its words
+typedef struct {
+    char* text;
+    float start;             // Start of the first word (window start if no word was aligned)
+    float end;               // End of the last word
+    WordTiming* words;
+    unsigned long word_count;
+} AlignmentSegment;
+
+typedef struct {
+    AlignmentSegment* segments;  // Same order as the texts passed to whisper_align
+    unsigned long segment_count;
+    char* language;
+    float duration;
+} AlignmentResult;
+
+// Allocator statistics for the tensors owned by the C++ layer
+typedef struct {
+    unsigned long hits;               // Allocations served from the cache
+    unsigned long misses;             // Allocations that reached the system allocator
+    unsigned long bytes_reserved;     // Bytes held by the allocator (cached + in use)
+    unsigned long bytes_in_use;       // Bytes currently handed out
+    unsigned long peak_bytes_in_use;  // High-water mark of bytes_in_use
+} AllocatorStats;
+
+// Window geometry of a streaming session (zero fields take the defaults)
+// Overlap, the audio decoded again at the start of the next window, is window_seconds - hop_seconds
+typedef struct {
+    unsigned int sample_rate;      // Rate of the audio written to the session in Hz (0 = 16000); resampled per window
+    float window_seconds;          // Audio decoded per window (0 = 4.2, at least 0.5)
+    float hop_seconds;             // Audio trimmed after each window (0 = window_seconds - 0.2)
+    float max_window_seconds;      // Largest catch-up window when decoding falls behind (0 = the model's 30s input)
+    bool auto_size;                // Grow the window from the measured real-time factor so decoding keeps up
+} WhisperStreamingConfig;
+
+// Result of writing audio into the streaming ingest ring
+typedef enum {
+    WHISPER_WRITE_BUFFERED = 0,       // Samples queued, no window due yet
+    WHISPER_WRITE_WINDOW_READY = 1,   // Samples queued, a full window is due for decoding
+    WHISPER_WRITE_DROPPED = 2,        // Chunk below the energy threshold (or empty), not queued
+    WHISPER_WRITE_OVERFLOW = 3,       // Ring full (decoder too far behind), chunk not queued
+    WHISPER_WRITE_NOT_STREAMING = 4   // whisper_start_streaming was not called
+} WhisperWriteStatus;
+
+// Sample format of streamed mel features
+typedef enum {
+    WHISPER_FEATURES_FP16 = 0,   // Half precision, 2 bytes per value
+    WHISPER_FEATURES_INT8 = 1    // 8-bit codes with a per-packet offset and scale, 1 byte per value
+} WhisperFeatureEncoding;
+
+// Result of pulling the next segment from a segment iterator
+typedef enum {
+    WHISPER_ITERATOR_SEGMENT = 0,           // A segment was returned
+    WHISPER_ITERATOR_FINISHED = 1,          // Whole audio decoded, no more segments
+    WHISPER_ITERATOR_CANCELLED = 2,         // whisper_iterator_cancel was called
+    WHISPER_ITERATOR_BUDGET_EXCEEDED = 3,   // Time budget ran out before the audio was fully decoded
+    WHISPER_ITERATOR_ERROR = 4              // Decoding failed
+} WhisperIteratorStatus;
+
+// Called for every decoded window of whisper_transcribe_progressive
+// Draft windows arrive first; each final window replaces the draft segments in [start, end)
+// segments are only valid for the duration of the call
+typedef void (*WhisperProgressiveCallback)(
+    void* context,
+    bool is_final,
+    float start,
+    float end,
+    const TranscriptionSegment* segments,
+    unsigned long segment_count
+);
+
+// What whisper_transcribe_with_embeddings passes to its callback for each window
+typedef enum {
+    WHISPER_EMBEDDING_FRAMES = 0,   // Full encoder output: positions x dim (1500 positions per 30s window)
+    WHISPER_EMBEDDING_POOLED = 1    // Mean over the positions covering audio: 1 x dim
+} WhisperEmbeddingMode;
+
+// Called for every file of whisper_transcribe_files, in order
+// result is NULL if the file could not be loaded or transcribed; it is only valid for the duration of the call
+typedef void (*WhisperFileCallback)(
+    void* context,
+    unsigned long index,
+    const char* path,
+    const TranscriptionResult* result
+);
+
+// Called after each window is encoded, before it is decoded
+// data is row-major positions x dim and only valid for the duration of the call; in frames mode it points
+// into the encoder output itself when the model computes in float32 (no copy)
+// content_positions counts the leading positions that cover audio (the rest encode padding)
+typedef void (*WhisperEmbeddingCallback)(
+    void* context,
+    float start,
+    float end,
+    const float* data,
+    unsigned long positions,
+    unsigned long dim,
+    unsigned long content_positions
+);
+
 // Audio processing functions
 FloatArray whisper_load_audio(const char* filename);
+// Load a stereo file as two 16kHz channels (returns false if loading fails or the file is mono)
+bool whisper_load_audio_stereo(const char* filename, FloatArray* left, FloatArray* right);
 FloatMatrix whisper_extract_mel_spectrogram(const float* audio, unsigned long length);
 
 // Model management functions
 WhisperModelHandle whisper_create_model(const char* model_path);
 void whisper_destroy_model(WhisperModelHandle model);
 
+// Allocator hit rate and memory footprint (zeroed if model is NULL)
+AllocatorStats whisper_get_allocator_stats(WhisperModelHandle model);
+
+// Throughput mode for bulk jobs: whisper_transcribe and whisper_transcribe_files speed speech up by factor
+// (pitch preserved, e.g. 1.25) so each encoder window covers more audio; timestamps stay in original time
+// 1 turns it off; returns false if factor is outside [1, 2]
+bool whisper_set_time_compression(WhisperModelHandle model, float factor);
+
+// Runaway guard for noisy audio: a fallback attempt still generating after tokens_per_second per second of
+// window (plus 32 tokens of slack) is cut off and the next temperature starts right away
+// 0 (the default) turns it off; returns false if tokens_per_second is negative
+bool whisper_set_token_budget(WhisperModelHandle model, float tokens_per_second);
+
 // Batch transcription
 TranscriptionResult whisper_transcribe(
     WhisperModelHandle model,
@@ -60,6 +206,19 @@ TranscriptionResult whisper_transcribe(
     const char* language  // NULL for auto-detect
 );
 
+// Transcribe many files in order; the next files are read, decoded and turned into features
+// on loader threads while the current one is transcribed (prefetch bounds how many wait in memory)
+// Returns the number of files transcribed
+unsigned long whisper_transcribe_files(
+    WhisperModelHandle model,
+    const char* const* paths,
+    unsigned long path_count,
+    const char* language,  // NULL for auto-detect (per file)
+    unsigned long prefetch,  // 0 defaults to 2
+    WhisperFileCallback callback,
+    void* context
+);
+
 // Translation (any language → English)
 TranscriptionResult whisper_translate(
     WhisperModelHandle model,
@@ -68,6 +227,96 @@ TranscriptionResult whisper_translate(
     const char* source_language  // NULL for auto-detect
 );
 
+// Batch transcription that also hands each window's encoder output to callback, so downstream
+// classifiers (speaker, audio events) can reuse the encoder work
+TranscriptionResult whisper_transcribe_with_embeddings(
+    WhisperModelHandle model,
+    const float* audio,
+    unsigned long audio_length,
+    const char* language,  // NULL for auto-detect
+    WhisperEmbeddingMode mode,
+    WhisperEmbeddingCallback callback,
+    void* context
+);
+
+// Progressive transcription: a fast draft pass, then the accurate pass, reported window by window
+// Blocks until the final pass is done and returns its result
+TranscriptionResult whisper_transcribe_progressive(
+    WhisperModelHandle model,
+    WhisperModelHandle draft_model,  // NULL to decode the draft pass greedily with model
+    const float* audio,
+    unsigned long audio_length,
+    const char* language,            // NULL for auto-detect
+    WhisperProgressiveCallback callback,
+    void* context
+);
+
+// Stereo transcription (one speaker per channel, decoded as a batch of two)
+StereoTranscriptionResult whisper_transcribe_stereo(
+    WhisperModelHandle model,
+    const float* left,
+    const float* right,
+    unsigned long audio_length,  // Samples per channel
+    const char* language         // NULL for auto-detect (on the left channel)
+);
+
+// Forced alignment of known texts (no decoding): word and segment timestamps
+// starts/ends give each text's time range in seconds (NULL, or a negative start, for an untimed text;
+// NULL ends, or an end <= start, means 30 seconds after start). Consecutive untimed texts are aligned
+// together after the previous timed text, so long audio needs at least one timed text every 30 seconds
+AlignmentResult whisper_align(
+    WhisperModelHandle model,
+    const float* audio,
+    unsigned long audio_length,
+    const char* const* texts,
+    const float* starts,
+    const float* ends,
+    unsigned long text_count,
+    const char* language  // NULL for auto-detect
+);
+
+// Lazy transcription of long audio: segments are decoded one 30s window at a time as they are pulled
+// time_budget_seconds <= 0 means no limit; returns NULL on failure
+WhisperSegmentIteratorHandle whisper_transcribe_iter(
+    WhisperModelHandle model,
+    const float* audio,
+    unsigned long audio_length,
+    const char* language,  // NULL for auto-detect
+    const char* task,      // "transcribe" or "translate", NULL defaults to "transcribe"
+    double time_budget_seconds
+);
+
+// Get the next segment (blocks while the next window is decoded)
+// On WHISPER_ITERATOR_SEGMENT, release segment with whisper_free_segment
+WhisperIteratorStatus whisper_iterator_next(
+    WhisperSegmentIteratorHandle iterator,
+    TranscriptionSegment* segment  // Output
+);
+
+// Stop before the next window (safe to call from another thread while whisper_iterator_next runs)
+void whisper_iterator_cancel(WhisperSegmentIteratorHandle iterator);
+
+// Seconds of audio decoded so far (safe to call from another thread while whisper_iterator_next runs)
+float whisper_iterator_progress(WhisperSegmentIteratorHandle iterator);
+
+// Must not be called while whisper_iterator_next is running
+void whisper_destroy_iterator(WhisperSegmentIteratorHandle iterator);
+
+// Snapshot an iterator between whisper_iterator_next calls so a preempted job can resume
+// (use whisper_iterator_progress to pick the interval); empty on failure
+ByteArray whisper_iterator_checkpoint(WhisperSegmentIteratorHandle iterator);
+
+// Resume from a checkpoint taken on the same audio; segments not returned before the checkpoint come first
+// Returns NULL if the checkpoint is corrupt or belongs to different audio
+WhisperSegmentIteratorHandle whisper_resume_iter(
+    WhisperModelHandle model,
+    const float* audio,
+    unsigned long audio_length,
+    const unsigned char* checkpoint,
+    unsigned long checkpoint_length,
+    double time_budget_seconds  // <= 0 means no limit
+);
+
 // Streaming transcription functions
 void whisper_start_streaming(
     WhisperModelHandle model,
@@ -75,13 +324,72 @@ void whisper_start_streaming(
     const char* task       // "transcribe" or "translate", NULL defaults to "transcribe"
 );
 
+// Start streaming with a per-session window geometry, e.g. short windows for voice commands
+// and long ones for dictation on the same model
+// Returns false (and starts nothing) if the geometry does not fit the model's input
+bool whisper_start_streaming_with_config(
+    WhisperModelHandle model,
+    const char* language,                  // NULL for auto-detect
+    const char* task,                      // "transcribe" or "translate", NULL defaults to "transcribe"
+    const WhisperStreamingConfig* config   // NULL for the defaults
+);
+
+// Current window size of the session in seconds (changes with auto_size), 0 if streaming not started
+float whisper_streaming_window_seconds(WhisperModelHandle model);
+
+// Length of the next window whisper_get_new_segments will decode, in seconds: one window normally, the
+// whole backlog (up to max_window_seconds) when behind; 0 if streaming not started
+// Call from the thread that calls whisper_get_new_segments
+float whisper_streaming_next_window_seconds(WhisperModelHandle model);
+
 void whisper_add_audio_chunk(
     WhisperModelHandle model,
     const float* chunk,
     unsigned long chunk_length
 );
 
+// Write audio from the capture thread into a lock-free ring (no allocation, one copy)
+// Safe to call concurrently with whisper_get_new_segments; only one writer per model
+// Chunks with mean absolute amplitude below energy_threshold are dropped (0 disables)
+WhisperWriteStatus whisper_write_audio(
+    WhisperModelHandle model,
+    const float* samples,
+    unsigned long sample_count,
+    float energy_threshold,
+    float* energy  // Output (optional): mean absolute amplitude of the chunk
+);
+
+// Let a capture service in another process feed this streaming session through shared memory
+// Creates a named POSIX shared-memory ring (name starts with '/', at most 31 characters on Apple platforms)
+// that whisper_get_new_segments drains like whisper_write_audio's ring; removed by whisper_stop_streaming
+// Returns false if streaming was not started or the region cannot be created (e.g. the name exists)
+bool whisper_attach_shared_ring(
+    WhisperModelHandle model,
+    const char* name,
+    unsigned long capacity_samples  // Rounded up to a power of two, e.g. 480000 for 30s
+);
+
+// Doorbell of the attached shared ring: readable once a full window is waiting (Linux eventfd)
+// Pass it to the capture process over a UNIX socket (SCM_RIGHTS) and poll it instead of whisper_is_window_ready
+// Returns -1 if no ring is attached or the platform has no eventfd
+int whisper_shared_ring_doorbell_fd(WhisperModelHandle model);
+
+// Capture-process side: map a ring created by whisper_attach_shared_ring
+// doorbell_fd is the descriptor received from the inference process (-1 for none); returns NULL on failure
+WhisperSharedRingHandle whisper_shared_ring_open(const char* name, int doorbell_fd);
+
+// Copy samples into the shared ring (no syscall unless this write completes a window)
+// Returns WHISPER_WRITE_OVERFLOW if the ring is full, WHISPER_WRITE_NOT_STREAMING once the session has stopped
+WhisperWriteStatus whisper_shared_ring_write(
+    WhisperSharedRingHandle ring,
+    const float* samples,
+    unsigned long sample_count
+);
+
+void whisper_shared_ring_close(WhisperSharedRingHandle ring);
+
 // Check if buffer has a full window ready for transcription (non-blocking)
+// Includes samples written with whisper_write_audio that have not been decoded yet
 bool whisper_is_window_ready(WhisperModelHandle model);
 
 // Trim samples from the buffer (for overflow handling when model is busy)
@@ -97,11 +405,76 @@ TranscriptionSegment* whisper_get_new_segments(
 
 void whisper_stop_streaming(WhisperModelHandle model);
 
+// Snapshot the streaming session (audio not decoded yet, window geometry, language, task, prompt history,
+// decode statistics) so it can continue on another process or host with the same model
+// Call from the decoding thread between whisper_get_new_segments calls, once the capture side has moved
+// to the new worker; empty on failure (e.g. streaming not started)
+ByteArray whisper_streaming_snapshot(WhisperModelHandle model);
+
+// Replace the model's streaming session with a snapshot (starts streaming if needed)
+// The next windows decode exactly what the original session would have; a shared ring is not restored
+// Returns false if the snapshot is corrupt or its geometry does not fit this model
+bool whisper_streaming_restore(
+    WhisperModelHandle model,
+    const unsigned char* snapshot,
+    unsigned long snapshot_length
+);
+
+// Split streaming: a capture device extracts log-mel features and sends them as compact packets
+// (1/8 of the bytes of float PCM with INT8); the server decodes them with the session's prompt history
+// Edge side: n_mels must match the server's model (80, or 128 for large-v3; 0 means 80)
+WhisperFeatureEncoderHandle whisper_feature_encoder_create(WhisperFeatureEncoding encoding, unsigned int n_mels);
+
+// Extract the features of one window of 16kHz audio and encode them as packets, ready to send
+// Empty on failure
+ByteArray whisper_feature_encode_window(
+    WhisperFeatureEncoderHandle encoder,
+    const float* audio,
+    unsigned long audio_length
+);
+
+void whisper_feature_encoder_destroy(WhisperFeatureEncoderHandle encoder);
+
+// Decode the first complete window in packet bytes, e.g. to check what a server will receive
+// dropped_windows (optional) receives the number of windows in the bytes skipped for missing packets
+// Empty if no window is complete; packets after a malformed one are ignored
+FloatMatrix whisper_feature_decode(
+    const unsigned char* data,
+    unsigned long length,
+    unsigned long* dropped_windows
+);
+
+// Server side: one session per connected device, independent of whisper_start_streaming
+WhisperFeatureSessionHandle whisper_feature_session_create(
+    WhisperModelHandle model,
+    const char* language,  // NULL for auto-detect
+    const char* task       // "transcribe" or "translate", NULL defaults to "transcribe"
+);
+
+// Feed received packet bytes (whole packets); every window they complete is transcribed
+// Windows with a lost packet are skipped; windows completed before a malformed packet are still transcribed
+// Returns NULL with count 0 if no window completed
+TranscriptionSegment* whisper_feature_session_push(
+    WhisperFeatureSessionHandle session,
+    const unsigned char* data,
+    unsigned long length,
+    unsigned long* count  // Output: number of segments
+);
+
+// Number of windows skipped because of lost packets
+unsigned long whisper_feature_session_dropped_windows(WhisperFeatureSessionHandle session);
+
+void whisper_feature_session_destroy(WhisperFeatureSessionHandle session);
+
 // Memory cleanup functions
 void whisper_free_float_array(FloatArray array);
 void whisper_free_float_matrix(FloatMatrix matrix);
+void whisper_free_byte_array(ByteArray array);
 void whisper_free_transcription_result(TranscriptionResult result);
+void whisper_free_stereo_transcription_result(StereoTranscriptionResult result);
+void whisper_free_alignment_result(AlignmentResult result);
 void whisper_free_segments(TranscriptionSegment* segments, unsigned long count);
+void whisper_free_segment(TranscriptionSegment segment);
 
 #ifdef __cplusplus
 }
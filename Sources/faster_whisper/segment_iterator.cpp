@@ -0,0 +1,129 @@
+//
+// segment_iterator.cpp
+// SwiftFasterWhisper
+//
+// Created by Amr Aboelela on 10/18/2026.
+//
+
+#include "segment_iterator.h"
+#include <algorithm>
+#include <stdexcept>
+
+SegmentIterator::SegmentIterator(WhisperModel& model,
+                                 std::vector<std::vector<float>> features,
+                                 std::unique_ptr<Tokenizer> tokenizer,
+                                 const std::string& task,
+                                 const TranscriptionOptions& options,
+                                 const TranscriptionInfo& info,
+                                 uint32_t audio_crc,
+                                 std::optional<std::chrono::steady_clock::time_point> deadline)
+    : model_(model),
+      features_(std::move(features)),
+      tokenizer_(std::move(tokenizer)),
+      task_(task),
+      options_(options),
+      info_(info),
+      audio_crc_(audio_crc),
+      deadline_(deadline)
+{
+    state_ = model_.begin_segments(features_, *tokenizer_, options_);
+    publish_progress();
+}
+
+bool SegmentIterator::next(Segment& segment) {
+    while (pending_.empty()) {
+        if (status_ != Status::Running) {
+            return false;
+        }
+        if (state_.finished) {
+            status_ = Status::Finished;
+            return false;
+        }
+
+        // Checked between windows: a window is the unit of work, so a cancelled
+        // or over-budget job never starts another encoder/decoder pass
+        if (cancelled_.load(std::memory_order_acquire)) {
+            status_ = Status::Cancelled;
+            return false;
+        }
+        if (deadline_ && std::chrono::steady_clock::now() >= *deadline_) {
+            status_ = Status::BudgetExceeded;
+            return false;
+        }
+
+        auto segments = model_.generate_next_segments(features_, *tokenizer_, options_, state_);
+        pending_.insert(pending_.end(), segments.begin(), segments.end());
+        publish_progress();
+
+        if (checkpoint_handler_ && !state_.finished && progress() - last_checkpoint_ >= checkpoint_interval_) {
+            last_checkpoint_ = progress();
+            checkpoint_handler_(checkpoint());
+        }
+    }
+
+    segment = std::move(pending_.front());
+    pending_.pop_front();
+    return true;
+}
+
+void SegmentIterator::cancel() {
+    cancelled_.store(true, std::memory_order_release);
+}
+
+SegmentIterator::Status SegmentIterator::status() const {
+    return status_;
+}
+
+float SegmentIterator::progress() const {
+    const size_t content_frames = features_.empty() || features_[0].empty() ? 0 : features_[0].size() - 1;
+    if (content_frames == 0) {
+        return 0.0f;
+    }
+    const int seek = published_seek_.load(std::memory_order_relaxed);
+    const float fraction = static_cast<float>(seek) / static_cast<float>(content_frames);
+    return std::min(fraction, 1.0f) * info_.duration;
+}
+
+void SegmentIterator::publish_progress() {
+    const size_t content_frames = features_.empty() || features_[0].empty() ? 0 : features_[0].size() - 1;
+    const int seek = state_.finished ? static_cast<int>(content_frames) : state_.seek;
+    published_seek_.store(seek, std::memory_order_relaxed);
+}
+
+const TranscriptionInfo& SegmentIterator::info() const {
+    return info_;
+}
+
+TranscriptionCheckpoint SegmentIterator::checkpoint() const {
+    TranscriptionCheckpoint checkpoint;
+    checkpoint.language = info_.language;
+    checkpoint.language_probability = info_.language_probability;
+    checkpoint.task = task_;
+    checkpoint.multilingual = options_.multilingual;
+    checkpoint.duration = info_.duration;
+    checkpoint.content_frames = features_.empty() || features_[0].empty() ? 0 : features_[0].size() - 1;
+    checkpoint.audio_crc = audio_crc_;
+    checkpoint.state = state_;
+    checkpoint.pending.assign(pending_.begin(), pending_.end());
+    return checkpoint;
+}
+
+void SegmentIterator::set_checkpoint_handler(float interval_seconds,
+                                             std::function<void(const TranscriptionCheckpoint&)> handler) {
+    checkpoint_interval_ = std::max(interval_seconds, 0.0f);
+    checkpoint_handler_ = std::move(handler);
+    last_checkpoint_ = progress();
+}
+
+void SegmentIterator::restore(const TranscriptionCheckpoint& checkpoint) {
+    const size_t content_frames = features_.empty() || features_[0].empty() ? 0 : features_[0].size() - 1;
+    if (checkpoint.content_frames != content_frames || checkpoint.audio_crc != audio_crc_) {
+        throw std::runtime_error("Transcription checkpoint was taken on different audio");
+    }
+
+    state_ = checkpoint.state;
+    publish_progress();
+    pending_.assign(checkpoint.pending.begin(), checkpoint.pending.end());
+    status_ = Status::Running;
+    last_checkpoint_ = progress();
+}
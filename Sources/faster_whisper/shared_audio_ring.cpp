@@ -0,0 +1,177 @@
+//
+// shared_audio_ring.cpp
+// SwiftFasterWhisper
+//
+// Created by Amr Aboelela on 10/18/2026.
+//
+
+#include "shared_audio_ring.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+std::unique_ptr<SharedAudioRing> SharedAudioRing::create(const std::string& name, size_t capacity) {
+    size_t rounded = 1;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+    const size_t mapping_size = DATA_OFFSET + rounded * sizeof(float);
+
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot create shared audio ring " + name + ": " + std::strerror(errno));
+    }
+    if (ftruncate(fd, static_cast<off_t>(mapping_size)) != 0) {
+        int error = errno;
+        close(fd);
+        shm_unlink(name.c_str());
+        throw std::runtime_error("Cannot size shared audio ring " + name + ": " + std::strerror(error));
+    }
+    void* mapping = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);  // The mapping keeps the region alive
+    if (mapping == MAP_FAILED) {
+        shm_unlink(name.c_str());
+        throw std::runtime_error("Cannot map shared audio ring " + name);
+    }
+
+    Header* header = new (mapping) Header;
+    header->capacity = rounded;
+    header->notify_threshold.store(0, std::memory_order_relaxed);
+    header->closed.store(0, std::memory_order_relaxed);
+    header->head.store(0, std::memory_order_relaxed);
+    header->tail.store(0, std::memory_order_relaxed);
+    header->version = VERSION;
+    // Published last: a producer that sees the magic sees an initialized header
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = MAGIC;
+
+    int doorbell = -1;
+#ifdef __linux__
+    doorbell = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+#endif
+
+    return std::unique_ptr<SharedAudioRing>(new SharedAudioRing(mapping, mapping_size, name, true, doorbell));
+}
+
+std::unique_ptr<SharedAudioRing> SharedAudioRing::open(const std::string& name, int doorbell_fd) {
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open shared audio ring " + name + ": " + std::strerror(errno));
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < DATA_OFFSET) {
+        close(fd);
+        throw std::runtime_error("Shared audio ring " + name + " is not initialized");
+    }
+    const size_t mapping_size = static_cast<size_t>(info.st_size);
+    void* mapping = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Cannot map shared audio ring " + name);
+    }
+
+    auto* header = static_cast<Header*>(mapping);
+    const bool valid = header->magic == MAGIC &&
+                       header->version == VERSION &&
+                       header->capacity > 0 &&
+                       (header->capacity & (header->capacity - 1)) == 0 &&
+                       DATA_OFFSET + header->capacity * sizeof(float) <= mapping_size;
+    if (!valid) {
+        munmap(mapping, mapping_size);
+        throw std::runtime_error("Shared audio ring " + name + " has an unsupported layout");
+    }
+
+    return std::unique_ptr<SharedAudioRing>(new SharedAudioRing(mapping, mapping_size, name, false, doorbell_fd));
+}
+
+SharedAudioRing::SharedAudioRing(void* mapping, size_t mapping_size, const std::string& name, bool owner, int doorbell_fd)
+    : mapping_(mapping),
+      mapping_size_(mapping_size),
+      header_(static_cast<Header*>(mapping)),
+      data_(reinterpret_cast<float*>(static_cast<char*>(mapping) + DATA_OFFSET)),
+      capacity_(static_cast<size_t>(header_->capacity)),
+      mask_(capacity_ - 1),
+      name_(name),
+      owner_(owner),
+      doorbell_fd_(doorbell_fd)
+{
+}
+
+SharedAudioRing::~SharedAudioRing() {
+    if (owner_) {
+        header_->closed.store(1, std::memory_order_release);
+        shm_unlink(name_.c_str());  // The producer's mapping stays valid until it closes
+        if (doorbell_fd_ >= 0) {
+            close(doorbell_fd_);
+        }
+    }
+    munmap(mapping_, mapping_size_);
+}
+
+bool SharedAudioRing::write(const float* samples, size_t count) {
+    const uint64_t head = header_->head.load(std::memory_order_relaxed);
+    const uint64_t tail = header_->tail.load(std::memory_order_acquire);
+    const size_t waiting = static_cast<size_t>(head - tail);
+    if (count > capacity_ - waiting) {
+        return false;  // Not enough room, drop the whole chunk
+    }
+
+    const size_t start = static_cast<size_t>(head) & mask_;
+    const size_t first = std::min(count, capacity_ - start);
+    std::memcpy(data_ + start, samples, first * sizeof(float));
+    if (first < count) {
+        std::memcpy(data_, samples + first, (count - first) * sizeof(float));
+    }
+
+    header_->head.store(head + count, std::memory_order_release);
+
+    // Only the write that completes a window wakes the consumer
+    const size_t threshold = static_cast<size_t>(header_->notify_threshold.load(std::memory_order_acquire));
+    if (doorbell_fd_ >= 0 && threshold > 0 && waiting < threshold && waiting + count >= threshold) {
+        uint64_t one = 1;
+        ssize_t written = ::write(doorbell_fd_, &one, sizeof(one));
+        (void)written;  // EAGAIN means the doorbell is already ringing
+    }
+    return true;
+}
+
+void SharedAudioRing::set_notify_threshold(size_t samples) {
+    header_->notify_threshold.store(samples, std::memory_order_release);
+}
+
+size_t SharedAudioRing::available() const {
+    return static_cast<size_t>(header_->head.load(std::memory_order_acquire) -
+                               header_->tail.load(std::memory_order_acquire));
+}
+
+size_t SharedAudioRing::capacity() const {
+    return capacity_;
+}
+
+void SharedAudioRing::clear() {
+    header_->tail.store(header_->head.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+bool SharedAudioRing::is_closed() const {
+    return header_->closed.load(std::memory_order_acquire) != 0;
+}
+
+int SharedAudioRing::doorbell_fd() const {
+    return doorbell_fd_;
+}
+
+void SharedAudioRing::drain_doorbell() {
+    if (owner_ && doorbell_fd_ >= 0) {
+        uint64_t value;
+        ssize_t drained = ::read(doorbell_fd_, &value, sizeof(value));
+        (void)drained;  // Non-blocking: EAGAIN when it was not rung
+    }
+}
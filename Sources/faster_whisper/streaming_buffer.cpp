@@ -7,49 +7,139 @@
 
 #include "streaming_buffer.h"
 #include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <stdexcept>
+#include <string>
 
-StreamingBuffer::StreamingBuffer(size_t sample_rate)
-    : sample_rate_(sample_rate),
-      window_start_(0)
+namespace {
+constexpr size_t MIN_SAMPLE_RATE = 8000;
+constexpr size_t MAX_SAMPLE_RATE = 192000;
+constexpr float MIN_WINDOW_SECONDS = 0.5f;       // Shorter windows carry too little context to decode
+constexpr float DEFAULT_OVERLAP_SECONDS = 0.2f;
+
+size_t seconds_to_samples(float seconds, size_t sample_rate) {
+    return static_cast<size_t>(std::lround(std::max(seconds, 0.0f) * sample_rate));
+}
+}
+
+StreamingGeometry StreamingGeometry::from_seconds(size_t sample_rate,
+                                                  float window_seconds,
+                                                  float hop_seconds,
+                                                  float max_window_seconds,
+                                                  bool auto_size,
+                                                  float max_input_seconds) {
+    StreamingGeometry geometry;
+    geometry.sample_rate = sample_rate;
+    geometry.window_samples = seconds_to_samples(window_seconds, sample_rate);
+    geometry.hop_samples = hop_seconds > 0.0f ?
+        seconds_to_samples(hop_seconds, sample_rate) :
+        seconds_to_samples(window_seconds - DEFAULT_OVERLAP_SECONDS, sample_rate);
+    geometry.max_window_samples = seconds_to_samples(max_window_seconds > 0.0f ? max_window_seconds : max_input_seconds,
+                                                     sample_rate);
+    geometry.auto_size = auto_size;
+    return geometry;
+}
+
+void StreamingGeometry::validate(float max_input_seconds) const {
+    if (sample_rate < MIN_SAMPLE_RATE || sample_rate > MAX_SAMPLE_RATE) {
+        throw std::invalid_argument("Sample rate " + std::to_string(sample_rate) + " Hz is outside " +
+                                    std::to_string(MIN_SAMPLE_RATE) + "-" + std::to_string(MAX_SAMPLE_RATE) + " Hz");
+    }
+    const size_t max_input_samples = seconds_to_samples(max_input_seconds, sample_rate);
+    if (window_samples < seconds_to_samples(MIN_WINDOW_SECONDS, sample_rate)) {
+        throw std::invalid_argument("Window is shorter than the 0.5s minimum");
+    }
+    if (hop_samples == 0 || hop_samples > window_samples) {
+        throw std::invalid_argument("Hop must be positive and no longer than the window");
+    }
+    if (max_window_samples > max_input_samples) {
+        throw std::invalid_argument("Maximum window exceeds the model's " + std::to_string(static_cast<int>(max_input_seconds)) + "s input");
+    }
+    if (window_samples > max_window_samples) {
+        throw std::invalid_argument("Window is longer than the maximum window");
+    }
+}
+
+StreamingBuffer::StreamingBuffer(const StreamingGeometry& geometry)
+    : geometry_(geometry),
+      window_samples_(geometry.window_samples),
+      window_start_(0),
+      ring_(geometry.max_window_samples)
 {
-    buffer_.reserve(WINDOW_SIZE_SAMPLES * 2);  // Reserve space for 8 seconds
+    buffer_.reserve(geometry_.window_samples * 2);  // Reserve space for two windows
 }
 
 void StreamingBuffer::add_chunk(const std::vector<float> &chunk) {
+    add_samples(chunk.data(), chunk.size());
+}
+
+void StreamingBuffer::add_samples(const float* samples, size_t count) {
     // Accumulate audio in the buffer
-    buffer_.insert(buffer_.end(), chunk.begin(), chunk.end());
+    buffer_.insert(buffer_.end(), samples, samples + count);
+    update_backlog();
+}
+
+bool StreamingBuffer::write(const float* samples, size_t count) {
+    return ring_.write(samples, count);
+}
+
+void StreamingBuffer::attach_shared_ring(std::unique_ptr<SharedAudioRing> ring) {
+    shared_ring_ = std::move(ring);
+    update_backlog();
+}
+
+const SharedAudioRing* StreamingBuffer::shared_ring() const {
+    return shared_ring_.get();
+}
+
+size_t StreamingBuffer::commit_pending() {
+    // Drain in at most two contiguous spans (ring wrap-around)
+    auto append = [this](const float* samples, size_t count) {
+        add_samples(samples, count);
+    };
+    size_t committed = ring_.consume_all(append);
+    if (shared_ring_) {
+        committed += shared_ring_->consume_all(append);
+    }
+    return committed;
+}
+
+bool StreamingBuffer::is_window_due() const {
+    size_t pending = ring_.available() + (shared_ring_ ? shared_ring_->available() : 0);
+    return backlog_.load(std::memory_order_acquire) + pending >= window_samples_.load(std::memory_order_acquire);
 }
 
 std::vector<float> StreamingBuffer::get_window() const {
-    // Check if we have enough samples for a full 4-second window
-    if (window_start_ >= buffer_.size() ||
-        window_start_ + WINDOW_SIZE_SAMPLES > buffer_.size()) {
+    // Check if we have enough samples for a full window
+    if (!is_ready_to_decode()) {
         // Not enough audio for a full window
         return std::vector<float>();
     }
 
-    // Return exactly 4 seconds from current window position
+    // Return one window (or the catch-up window) from current window position
     return std::vector<float>(
         buffer_.begin() + window_start_,
-        buffer_.begin() + window_start_ + WINDOW_SIZE_SAMPLES
+        buffer_.begin() + window_start_ + window_size()
     );
 }
 
 bool StreamingBuffer::is_ready_to_decode() const {
-    // Check if we have at least 4 seconds from the current window position
+    // Check if we have at least one window from the current window position
+    // Samples still in the ingest ring are not counted until commit_pending()
     return window_start_ < buffer_.size() &&
-           (window_start_ + WINDOW_SIZE_SAMPLES) <= buffer_.size();
+           (window_start_ + window_samples_.load(std::memory_order_relaxed)) <= buffer_.size();
 }
 
 void StreamingBuffer::slide_window() {
-    // Slide the window forward by 3.5 seconds
+    // Slide the window forward by one hop
     // Make sure we don't go beyond the buffer
-    size_t new_position = window_start_ + SLIDE_SIZE_SAMPLES;
+    size_t new_position = window_start_ + geometry_.hop_samples;
 
-    // Only slide if we'll still have a full 4-second window available
-    if (new_position + WINDOW_SIZE_SAMPLES <= buffer_.size()) {
+    // Only slide if we'll still have a full window available
+    if (new_position + window_samples_.load(std::memory_order_relaxed) <= buffer_.size()) {
         window_start_ = new_position;
+        update_backlog();
     }
     // If we can't slide anymore, window_start_ stays at current position
 }
@@ -65,11 +155,17 @@ void StreamingBuffer::trim_samples(size_t samples) {
         // Reset window to start
         window_start_ = 0;
     }
+    update_backlog();
 }
 
 void StreamingBuffer::reset() {
     buffer_.clear();
     window_start_ = 0;
+    ring_.clear();
+    if (shared_ring_) {
+        shared_ring_->clear();
+    }
+    update_backlog();
 }
 
 size_t StreamingBuffer::size() const {
@@ -77,9 +173,75 @@ size_t StreamingBuffer::size() const {
 }
 
 float StreamingBuffer::duration() const {
-    return static_cast<float>(buffer_.size()) / sample_rate_;
+    return static_cast<float>(buffer_.size()) / geometry_.sample_rate;
 }
 
 size_t StreamingBuffer::window_position() const {
     return window_start_;
 }
+
+size_t StreamingBuffer::window_size() const {
+    if (!is_catching_up()) {
+        return window_samples_.load(std::memory_order_relaxed);
+    }
+    return std::min(buffer_.size() - window_start_, geometry_.max_window_samples);
+}
+
+size_t StreamingBuffer::window_shift() const {
+    return window_size() - geometry_.overlap_samples();
+}
+
+bool StreamingBuffer::is_catching_up() const {
+    // A second window is already complete, so decoding is not keeping up with capture
+    const size_t window = window_samples_.load(std::memory_order_relaxed);
+    return window_start_ < buffer_.size() &&
+           buffer_.size() - window_start_ >= window + (window - geometry_.overlap_samples());
+}
+
+size_t StreamingBuffer::base_window_size() const {
+    return window_samples_.load(std::memory_order_acquire);
+}
+
+const StreamingGeometry& StreamingBuffer::geometry() const {
+    return geometry_;
+}
+
+void StreamingBuffer::record_decode(double seconds, size_t window_samples) {
+    if (window_samples == 0 || seconds <= 0.0) {
+        return;
+    }
+
+    const double window_seconds = static_cast<double>(window_samples) / geometry_.sample_rate;
+    const bool first = decode_seconds_ == 0.0;
+    decode_seconds_ = first ? seconds : DECODE_SMOOTHING * seconds + (1.0 - DECODE_SMOOTHING) * decode_seconds_;
+    const double rtf = seconds / window_seconds;
+    real_time_factor_ = first ? rtf : DECODE_SMOOTHING * rtf + (1.0 - DECODE_SMOOTHING) * real_time_factor_;
+
+    if (!geometry_.auto_size) {
+        return;
+    }
+
+    // Decode cost is nearly flat per window (the encoder always sees 30s), so the hop has to
+    // cover one decode for capture not to outrun decoding; shrink back when decoding speeds up
+    const size_t needed_hop = static_cast<size_t>(decode_seconds_ * AUTO_SIZE_HEADROOM * geometry_.sample_rate);
+    const size_t window = std::min(std::max(geometry_.window_samples, geometry_.overlap_samples() + needed_hop),
+                                   geometry_.max_window_samples);
+    if (window != window_samples_.load(std::memory_order_relaxed)) {
+        window_samples_.store(window, std::memory_order_release);
+        update_backlog();
+    }
+}
+
+double StreamingBuffer::real_time_factor() const {
+    return real_time_factor_;
+}
+
+void StreamingBuffer::update_backlog() {
+    size_t backlog = buffer_.size() > window_start_ ? buffer_.size() - window_start_ : 0;
+    backlog_.store(backlog, std::memory_order_release);
+    if (shared_ring_) {
+        // The producer rings the doorbell once the samples still missing for a window arrive
+        const size_t window = window_samples_.load(std::memory_order_relaxed);
+        shared_ring_->set_notify_threshold(window > backlog ? window - backlog : 1);
+    }
+}
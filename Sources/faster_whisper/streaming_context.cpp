@@ -0,0 +1,65 @@
+//
+// streaming_context.cpp
+// SwiftFasterWhisper
+//
+// Created by Amr Aboelela on 10/18/2026.
+//
+
+#include "streaming_context.h"
+
+StreamingContext::StreamingContext(const std::optional<std::string>& language, const std::string& task)
+    : StreamingContext(language, task, ResetPolicy())
+{
+}
+
+StreamingContext::StreamingContext(const std::optional<std::string>& language,
+                                   const std::string& task,
+                                   const ResetPolicy& policy)
+    : language_(language), task_(task), policy_(policy)
+{
+}
+
+void StreamingContext::update(const std::vector<Segment>& decoded_segments,
+                              const std::vector<Segment>& accepted_segments) {
+    // Same rule generate_segments uses between its own windows: text decoded at a high
+    // temperature is unreliable and would steer the next window the wrong way
+    for (const auto& segment : decoded_segments) {
+        if (segment.temperature.value_or(0.0f) > policy_.reset_on_temperature) {
+            reset();
+            return;
+        }
+    }
+
+    if (accepted_segments.empty()) {
+        // A long pause usually means a new utterance, which should not be conditioned on the old one
+        if (++silent_windows_ >= policy_.max_silent_windows) {
+            reset();
+        }
+        return;
+    }
+
+    silent_windows_ = 0;
+    for (const auto& segment : accepted_segments) {
+        history_.insert(history_.end(), segment.tokens.begin(), segment.tokens.end());
+    }
+    if (history_.size() > policy_.max_history_tokens) {
+        history_.erase(history_.begin(), history_.end() - policy_.max_history_tokens);
+    }
+}
+
+void StreamingContext::reset() {
+    history_.clear();
+    silent_windows_ = 0;
+}
+
+const std::vector<int>& StreamingContext::history() const {
+    return history_;
+}
+
+const std::optional<std::string>& StreamingContext::language() const {
+    return language_;
+}
+
+const std::string& StreamingContext::task() const {
+    return task_;
+}
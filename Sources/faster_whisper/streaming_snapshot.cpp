@@ -0,0 +1,157 @@
+//
+// streaming_snapshot.cpp
+// SwiftFasterWhisper
+//
+// Created by Amr Aboelela on 10/18/2026.
+//
+
+#include "streaming_snapshot.h"
+#include "byte_stream.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <zlib.h>
+
+namespace {
+
+constexpr char MAGIC[4] = {'F', 'W', 'S', 'S'};
+constexpr uint32_t VERSION = 1;
+
+}
+
+StreamingSnapshot StreamingSnapshot::capture(StreamingBuffer& buffer, const StreamingContext& context) {
+    buffer.commit_pending();
+
+    StreamingSnapshot snapshot;
+    snapshot.geometry = buffer.geometry_;
+    snapshot.window_samples = buffer.window_samples_.load(std::memory_order_acquire);
+    snapshot.decode_seconds = buffer.decode_seconds_;
+    snapshot.real_time_factor = buffer.real_time_factor_;
+    snapshot.audio.assign(buffer.buffer_.begin() + std::min(buffer.window_start_, buffer.buffer_.size()), buffer.buffer_.end());
+
+    snapshot.language = context.language_;
+    snapshot.task = context.task_;
+    snapshot.policy = context.policy_;
+    snapshot.history = context.history_;
+    snapshot.silent_windows = context.silent_windows_;
+    if (context.tokenizer_) {
+        snapshot.detected_language = context.detected_language_;
+        snapshot.language_probability = context.language_probability_;
+    }
+    return snapshot;
+}
+
+std::unique_ptr<StreamingBuffer> StreamingSnapshot::restore_buffer() const {
+    auto buffer = std::make_unique<StreamingBuffer>(geometry);
+    buffer->window_samples_.store(std::min(std::max(window_samples, geometry.window_samples), geometry.max_window_samples),
+                                  std::memory_order_release);
+    buffer->decode_seconds_ = decode_seconds;
+    buffer->real_time_factor_ = real_time_factor;
+    buffer->add_samples(audio.data(), audio.size());
+    return buffer;
+}
+
+std::unique_ptr<StreamingContext> StreamingSnapshot::restore_context() const {
+    auto context = std::make_unique<StreamingContext>(language, task, policy);
+    context->history_ = history;
+    context->silent_windows_ = silent_windows;
+    if (!detected_language.empty()) {
+        context->detected_language_ = detected_language;
+        context->language_probability_ = language_probability;
+        context->language_resolved_ = true;
+    }
+    return context;
+}
+
+std::vector<uint8_t> StreamingSnapshot::serialize() const {
+    ByteWriter writer;
+    for (char c : MAGIC) {
+        writer.u8(static_cast<uint8_t>(c));
+    }
+    writer.u32(VERSION);
+
+    writer.u64(geometry.sample_rate);
+    writer.u64(geometry.window_samples);
+    writer.u64(geometry.hop_samples);
+    writer.u64(geometry.max_window_samples);
+    writer.u8(geometry.auto_size ? 1 : 0);
+    writer.u64(window_samples);
+    writer.f64(decode_seconds);
+    writer.f64(real_time_factor);
+
+    writer.u8(language.has_value() ? 1 : 0);
+    writer.string(language.value_or(""));
+    writer.string(task);
+    writer.u64(policy.max_history_tokens);
+    writer.f32(policy.reset_on_temperature);
+    writer.u64(policy.max_silent_windows);
+    writer.ints(history);
+    writer.u64(silent_windows);
+    writer.string(detected_language);
+    writer.f32(language_probability);
+
+    // Capture audio is 16-bit at the source, so 16-bit PCM loses nothing the decoder would notice
+    writer.u64(audio.size());
+    for (float sample : audio) {
+        const float clamped = std::min(std::max(sample, -1.0f), 1.0f);
+        writer.u16(static_cast<uint16_t>(static_cast<int16_t>(std::lround(clamped * 32767.0f))));
+    }
+
+    auto& bytes = writer.bytes();
+    uint32_t crc = static_cast<uint32_t>(crc32(0L, bytes.data(), static_cast<uInt>(bytes.size())));
+    writer.u32(crc);
+    return std::move(bytes);
+}
+
+StreamingSnapshot StreamingSnapshot::deserialize(const uint8_t* data, size_t size) {
+    if (!data || size < sizeof(MAGIC) + 8 || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Not a streaming snapshot");
+    }
+
+    ByteReader trailer(data + size - 4, 4, "Streaming snapshot");
+    uint32_t expected_crc = trailer.u32();
+    if (static_cast<uint32_t>(crc32(0L, data, static_cast<uInt>(size - 4))) != expected_crc) {
+        throw std::runtime_error("Streaming snapshot is corrupt (CRC mismatch)");
+    }
+
+    ByteReader reader(data + sizeof(MAGIC), size - sizeof(MAGIC) - 4, "Streaming snapshot");
+    uint32_t version = reader.u32();
+    if (version != VERSION) {
+        throw std::runtime_error("Unsupported streaming snapshot version " + std::to_string(version));
+    }
+
+    StreamingSnapshot snapshot;
+    snapshot.geometry.sample_rate = reader.u64();
+    snapshot.geometry.window_samples = reader.u64();
+    snapshot.geometry.hop_samples = reader.u64();
+    snapshot.geometry.max_window_samples = reader.u64();
+    snapshot.geometry.auto_size = reader.u8() != 0;
+    snapshot.window_samples = reader.u64();
+    snapshot.decode_seconds = reader.f64();
+    snapshot.real_time_factor = reader.f64();
+
+    bool has_language = reader.u8() != 0;
+    std::string language = reader.string();
+    if (has_language) {
+        snapshot.language = language;
+    }
+    snapshot.task = reader.string();
+    snapshot.policy.max_history_tokens = reader.u64();
+    snapshot.policy.reset_on_temperature = reader.f32();
+    snapshot.policy.max_silent_windows = reader.u64();
+    snapshot.history = reader.ints();
+    snapshot.silent_windows = reader.u64();
+    snapshot.detected_language = reader.string();
+    snapshot.language_probability = reader.f32();
+
+    uint64_t sample_count = reader.u64();
+    reader.require(sample_count > SIZE_MAX / 2 ? SIZE_MAX : static_cast<size_t>(sample_count) * 2);
+    snapshot.audio.resize(sample_count);
+    for (auto& sample : snapshot.audio) {
+        sample = static_cast<int16_t>(reader.u16()) / 32767.0f;
+    }
+
+    return snapshot;
+}
@@ -1,9 +1,13 @@
 
 #include "transcribe.h"
 #include "utils.h"
+#include "segment_iterator.h"
+#include "batch_loader.h"
+#include "streaming_context.h"
 #include "whisper_tokenizer.h"
 #include <ctranslate2/models/whisper.h>
 #include <ctranslate2/storage_view.h>
+#include <ctranslate2/ops/gather.h>
 #include <string>
 #include <memory>
 #include <filesystem>
@@ -21,6 +25,9 @@
 #include <chrono>
 #include <ctime>
 #include <sstream>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 // Helper function to log with timestamp
 std::string getTranscribeTimestamp() {
@@ -60,6 +67,7 @@ std::vector<std::vector<float>> pad_or_trim(const std::vector<std::vector<float>
 #include <chrono>
 #include "audio.h"
 #include "feature_extractor.h"
+#include "time_compression.h"
 #ifdef ANDROID
 #include <android/log.h>
 #else
@@ -183,6 +191,12 @@ WhisperModel::WhisperModel(
   tokens_per_second = feature_extractor.sampling_rate() / num_samples_per_token;
   time_precision = 0.02;
   max_length = 448;  // Match Python's whisper max_length exactly
+
+  // Window shapes are fixed, so reserve the encoder input block up front:
+  // the first window then hits the cache like every later one
+  tensor_allocator_.reserve(
+    feature_extractor.mel_filters.size() * feature_extractor.nb_max_frames() * sizeof(float)
+  );
 }
 
 std::vector<std::string> WhisperModel::supported_languages() const {
@@ -213,30 +227,69 @@ std::map<std::string, std::string> WhisperModel::get_feature_kwargs(
   return config;
 }
 
+// Move segment and word timestamps of time-compressed audio back to the original timeline
+static void map_to_original_time(std::vector<Segment> &segments, TranscriptionInfo &info, const whisper::TimeMap &time_map) {
+  for (auto &segment : segments) {
+    segment.start = time_map.to_original(segment.start);
+    segment.end = time_map.to_original(segment.end);
+    if (segment.words.has_value()) {
+      for (auto &word : *segment.words) {
+        word.start = time_map.to_original(word.start);
+        word.end = time_map.to_original(word.end);
+      }
+    }
+  }
+  info.duration = time_map.original_duration;
+}
+
 std::tuple<std::vector<Segment>, TranscriptionInfo> WhisperModel::transcribe(
   const std::vector<float> &audio,
   const std::optional<std::string> &language,
   bool multilingual,
-  const std::string &task
+  const std::string &task,
+  const std::function<void(const EncoderWindow &)> &on_encoder_output
 ) {
-  // Step 1: Validate multilingual setting based on model capability
-  if (multilingual && !model->is_multilingual()) {
-    std::cerr << "The current model is English-only but multilingual parameter is set to True; setting to False instead." << std::endl;
-    multilingual = false;
-  }
-
-  // Step 2: Calculate duration
+  // Step 1: Calculate duration
   float duration = static_cast<float>(audio.size()) / feature_extractor.sampling_rate();
-  float duration_after_vad = duration;
 
-  // Step 3: Extract features from the entire audio
-  auto features = feature_extractor.extract(audio);
+  // Step 2: Extract features from the entire audio (time-compressed first in throughput mode)
+  std::vector<float> compressed;
+  whisper::TimeMap time_map;
+  if (time_compression_ > 1.0f) {
+    compressed = whisper::compress_time(audio, time_compression_, time_map, feature_extractor.sampling_rate());
+  }
+  auto features = feature_extractor.extract(compressed.empty() ? audio : compressed);
   if (features.empty() || features[0].empty()) {
     throw std::runtime_error("Failed to extract features from audio");
   }
 
   std::cout << "#debug 🔄 Transcribing " << std::fixed << std::setprecision(1) << duration << "s..." << std::endl;
 
+  if (compressed.empty()) {
+    return transcribe_features(features, duration, language, multilingual, task, on_encoder_output);
+  }
+
+  compressed = {};
+  auto [segments, info] = transcribe_features(features, time_map.compressed_duration, language, multilingual, task,
+                                             on_encoder_output);
+  map_to_original_time(segments, info, time_map);
+  return std::make_tuple(segments, info);
+}
+
+std::tuple<std::vector<Segment>, TranscriptionInfo> WhisperModel::transcribe_features(
+  const std::vector<std::vector<float>> &features,
+  float duration,
+  const std::optional<std::string> &language,
+  bool multilingual,
+  const std::string &task,
+  const std::function<void(const EncoderWindow &)> &on_encoder_output
+) {
+  // Step 3: Validate multilingual setting based on model capability
+  if (multilingual && !model->is_multilingual()) {
+    std::cerr << "The current model is English-only but multilingual parameter is set to True; setting to False instead." << std::endl;
+    multilingual = false;
+  }
+
   // Log feature statistics for debugging (commented out for production)
   /*
   if (!features.empty() && !features[0].empty()) {
@@ -281,7 +334,633 @@ std::tuple<std::vector<Segment>, TranscriptionInfo> WhisperModel::transcribe(
   }
   */
 
-  // Step 4: Language detection - follows Python logic exactly
+  // Step 4: Language detection - follows Python logic exactly
+  auto [detected_language, language_probability, all_language_probs] = resolve_language(language, features);
+
+  // Step 5: Use cached vocabulary for tokenizer initialization
+  if (!vocabulary_) {
+    throw std::runtime_error("Vocabulary not loaded. This should not happen.");
+  }
+
+  const ctranslate2::Vocabulary& vocabulary = *vocabulary_;
+
+  // Use the CTranslate2 vocabulary to create the tokenizer
+  Tokenizer tokenizer(vocabulary, model->is_multilingual(), task, detected_language);
+
+  // Debug tokenizer initialization
+  // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "🧪 Testing tokenizer methods...");
+
+  try {
+    int sot = tokenizer.get_sot();
+    int sot_prev = tokenizer.get_sot_prev();
+    int eot = tokenizer.get_eot();
+    int transcribe_token = tokenizer.get_transcribe();
+    auto sot_seq = tokenizer.get_sot_sequence();
+
+    // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "SOT token: %d", sot);
+    // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "SOT_PREV token: %d", sot_prev);
+    // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "EOT token: %d", eot);
+    // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "TRANSCRIBE token: %d", transcribe_token);
+    // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "SOT sequence length: %zu", sot_seq.size());
+
+    // std::string sot_seq_str = "SOT sequence: ";
+    // for (size_t i = 0; i < sot_seq.size(); ++i) {
+    //   sot_seq_str += std::to_string(sot_seq[i]);
+    //   if (i < sot_seq.size() - 1) sot_seq_str += ", ";
+    // }
+    // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "%s", sot_seq_str.c_str());
+  } catch (const std::exception& e) {
+    // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "Error testing tokenizer methods: %s", e.what());
+  }
+
+  // Step 6: Set up transcription options (Python line 956-989)
+  TranscriptionOptions options = default_transcription_options(multilingual, duration);
+
+  // Step 7: Generate segments using the same logic as Python (line 991-993)
+  std::vector<Segment> segments = generate_segments(features, tokenizer, options, on_encoder_output);
+
+  // Step 8: Create transcription info (Python line 998-1006)
+  TranscriptionInfo info;
+  info.language = detected_language;
+  info.language_probability = language_probability;
+  info.duration = duration;
+  info.transcription_options = options;
+  info.all_language_probs = all_language_probs;
+
+  return std::make_tuple(segments, info);
+}
+
+size_t WhisperModel::transcribe_files(
+  const std::vector<std::string> &paths,
+  const std::function<void(const FileTranscription &)> &on_file,
+  const std::optional<std::string> &language,
+  bool multilingual,
+  const std::string &task,
+  size_t prefetch
+) {
+  // Files N+1..N+prefetch are read, decoded and turned into features while file N is transcribed
+  BatchLoader loader(paths, feature_extractor, prefetch, prefetch, time_compression_);
+
+  size_t transcribed = 0;
+  LoadedAudio loaded;
+  while (loader.next(loaded)) {
+    FileTranscription file;
+    file.index = loaded.index;
+    file.path = loaded.path;
+    file.error = loaded.error;
+
+    if (file.error.empty()) {
+      try {
+        std::cout << "#debug 🔄 Transcribing " << loaded.path << " (" << std::fixed << std::setprecision(1)
+                  << loaded.duration << "s)..." << std::endl;
+        if (loaded.time_map.factor > 1.0f) {
+          std::tie(file.segments, file.info) = transcribe_features(loaded.features, loaded.time_map.compressed_duration, language, multilingual, task);
+          map_to_original_time(file.segments, file.info, loaded.time_map);
+        } else {
+          std::tie(file.segments, file.info) = transcribe_features(loaded.features, loaded.duration, language, multilingual, task);
+        }
+        transcribed++;
+      } catch (const std::exception &e) {
+        file.error = e.what();
+      }
+    }
+
+    // Release this file's features before the next one is handed out
+    loaded.features = {};
+    on_file(file);
+  }
+
+  return transcribed;
+}
+
+// The budget covers feature extraction and language detection too: it is wall-clock time from the caller's point of view
+static std::optional<std::chrono::steady_clock::time_point> make_deadline(std::optional<double> time_budget_seconds) {
+  if (!time_budget_seconds.has_value()) {
+    return std::nullopt;
+  }
+  return std::chrono::steady_clock::now() +
+    std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(*time_budget_seconds));
+}
+
+std::unique_ptr<SegmentIterator> WhisperModel::transcribe_iter(
+  const std::vector<float> &audio,
+  const std::optional<std::string> &language,
+  bool multilingual,
+  const std::string &task,
+  std::optional<double> time_budget_seconds
+) {
+  auto deadline = make_deadline(time_budget_seconds);
+
+  if (multilingual && !model->is_multilingual()) {
+    std::cerr << "The current model is English-only but multilingual parameter is set to True; setting to False instead." << std::endl;
+    multilingual = false;
+  }
+
+  float duration = static_cast<float>(audio.size()) / feature_extractor.sampling_rate();
+
+  auto features = feature_extractor.extract(audio);
+  if (features.empty() || features[0].empty()) {
+    throw std::runtime_error("Failed to extract features from audio");
+  }
+
+  auto [detected_language, language_probability, all_language_probs] = resolve_language(language, features);
+
+  if (!vocabulary_) {
+    throw std::runtime_error("Vocabulary not loaded. This should not happen.");
+  }
+  auto tokenizer = std::make_unique<Tokenizer>(*vocabulary_, model->is_multilingual(), task, detected_language);
+
+  TranscriptionOptions options = default_transcription_options(multilingual, duration);
+
+  TranscriptionInfo info;
+  info.language = detected_language;
+  info.language_probability = language_probability;
+  info.duration = duration;
+  info.transcription_options = options;
+  info.all_language_probs = all_language_probs;
+
+  return std::make_unique<SegmentIterator>(*this, std::move(features), std::move(tokenizer), task, options, info,
+                                           TranscriptionCheckpoint::audio_digest(audio), deadline);
+}
+
+// Thrown from the draft pass's update callback to stop it once the final pass is done
+struct DraftPassStopped {};
+
+std::tuple<std::vector<Segment>, TranscriptionInfo> WhisperModel::transcribe_progressive(
+  const std::vector<float> &audio,
+  const std::function<void(const ProgressiveUpdate &)> &on_update,
+  const std::optional<std::string> &language,
+  bool multilingual,
+  const std::string &task,
+  WhisperModel *draft_model
+) {
+  if (multilingual && !model->is_multilingual()) {
+    std::cerr << "The current model is English-only but multilingual parameter is set to True; setting to False instead." << std::endl;
+    multilingual = false;
+  }
+
+  float duration = static_cast<float>(audio.size()) / feature_extractor.sampling_rate();
+
+  auto features = feature_extractor.extract(audio);
+  if (features.empty() || features[0].empty()) {
+    throw std::runtime_error("Failed to extract features from audio");
+  }
+
+  // Resolve the language once so both passes decode the same language
+  auto [detected_language, language_probability, all_language_probs] = resolve_language(language, features);
+
+  if (!vocabulary_) {
+    throw std::runtime_error("Vocabulary not loaded. This should not happen.");
+  }
+  Tokenizer tokenizer(*vocabulary_, model->is_multilingual(), task, detected_language);
+
+  // The draft pass runs on its own thread so the final pass starts right away instead of after the
+  // whole draft, but only when it has its own replica to run on: a separate draft model, or a second
+  // replica of this one. With a single replica the passes would just queue behind each other, so the
+  // draft runs first on this thread instead
+  // Updates of both passes go through one lock, so on_update is never called concurrently;
+  // draft windows (or the part of one) the final pass has already reported are dropped
+  const bool separate_draft_model = draft_model && draft_model != this;
+  const bool concurrent = separate_draft_model || model->num_replicas() > 1;
+  std::mutex update_mutex;
+  float final_end = 0.0f;
+  bool final_done = false;
+  auto report_draft = [&](const ProgressiveUpdate &update) {
+    std::lock_guard<std::mutex> lock(update_mutex);
+    if (final_done) {
+      throw DraftPassStopped();
+    }
+    if (update.end <= final_end) {
+      return;
+    }
+    ProgressiveUpdate draft = update;
+    if (draft.start < final_end) {
+      draft.start = final_end;
+      draft.segments.erase(
+        std::remove_if(draft.segments.begin(), draft.segments.end(),
+                       [&](const Segment &segment) { return segment.start < final_end; }),
+        draft.segments.end()
+      );
+    }
+    on_update(draft);
+  };
+  auto report_final = [&](const ProgressiveUpdate &update) {
+    std::lock_guard<std::mutex> lock(update_mutex);
+    final_end = std::max(final_end, update.end);
+    on_update(update);
+  };
+
+  // Pass 1: draft
+  const std::string draft_language = detected_language;
+  auto run_draft = [&, draft_language]() {
+    try {
+      if (separate_draft_model) {
+        // The draft model may use a different number of mel bins, so it extracts its own features
+        draft_model->draft_pass(audio, draft_language, task, report_draft);
+      } else {
+        // Own tokenizer: the final pass uses the other one at the same time
+        Tokenizer draft_tokenizer(*vocabulary_, model->is_multilingual(), task, draft_language);
+        decode_pass(features, draft_tokenizer, draft_transcription_options(duration), ProgressivePass::Draft, report_draft);
+      }
+    } catch (const DraftPassStopped &) {
+      // The final pass finished first
+    } catch (const std::exception &e) {
+      std::cerr << "Draft pass failed: " << e.what() << std::endl;
+    }
+  };
+  std::thread draft_thread;
+  if (concurrent) {
+    draft_thread = std::thread(run_draft);
+  } else {
+    run_draft();
+  }
+  auto stop_draft = [&]() {
+    {
+      std::lock_guard<std::mutex> lock(update_mutex);
+      final_done = true;
+    }
+    if (draft_thread.joinable()) {
+      draft_thread.join();
+    }
+  };
+
+  // Pass 2: final, concurrently with the draft when it has its own replica
+  TranscriptionOptions options = default_transcription_options(multilingual, duration);
+  std::vector<Segment> segments;
+  try {
+    segments = decode_pass(features, tokenizer, options, ProgressivePass::Final, report_final);
+  } catch (...) {
+    stop_draft();
+    throw;
+  }
+  stop_draft();
+
+  TranscriptionInfo info;
+  info.language = detected_language;
+  info.language_probability = language_probability;
+  info.duration = duration;
+  info.transcription_options = options;
+  info.all_language_probs = all_language_probs;
+
+  return std::make_tuple(segments, info);
+}
+
+std::vector<Segment> WhisperModel::draft_pass(
+  const std::vector<float> &audio,
+  const std::string &language,
+  const std::string &task,
+  const std::function<void(const ProgressiveUpdate &)> &on_update
+) {
+  float duration = static_cast<float>(audio.size()) / feature_extractor.sampling_rate();
+
+  auto features = feature_extractor.extract(audio);
+  if (features.empty() || features[0].empty()) {
+    throw std::runtime_error("Failed to extract features from audio");
+  }
+
+  if (!vocabulary_) {
+    throw std::runtime_error("Vocabulary not loaded. This should not happen.");
+  }
+  Tokenizer tokenizer(*vocabulary_, model->is_multilingual(), task, language);
+
+  return decode_pass(features, tokenizer, draft_transcription_options(duration), ProgressivePass::Draft, on_update);
+}
+
+std::vector<Segment> WhisperModel::decode_pass(
+  const std::vector<std::vector<float>> &features,
+  Tokenizer &tokenizer,
+  const TranscriptionOptions &options,
+  ProgressivePass pass,
+  const std::function<void(const ProgressiveUpdate &)> &on_update
+) {
+  std::vector<Segment> all_segments;
+  SegmentGenerationState state = begin_segments(features, tokenizer, options);
+
+  while (true) {
+    int window_start = state.seek;
+    auto segments = generate_next_segments(features, tokenizer, options, state);
+    if (state.finished) {
+      break;  // No window left to decode
+    }
+
+    // Report the window's time range even when it is silent, so a final window can clear draft text
+    ProgressiveUpdate update;
+    update.pass = pass;
+    update.start = window_start * feature_extractor.time_per_frame();
+    update.end = state.seek * feature_extractor.time_per_frame();
+    update.segments = segments;
+    on_update(update);
+
+    all_segments.insert(all_segments.end(), segments.begin(), segments.end());
+  }
+
+  return all_segments;
+}
+
+std::unique_ptr<SegmentIterator> WhisperModel::resume_iter(
+  const std::vector<float> &audio,
+  const TranscriptionCheckpoint &checkpoint,
+  std::optional<double> time_budget_seconds
+) {
+  auto deadline = make_deadline(time_budget_seconds);
+
+  float duration = static_cast<float>(audio.size()) / feature_extractor.sampling_rate();
+
+  auto features = feature_extractor.extract(audio);
+  if (features.empty() || features[0].empty()) {
+    throw std::runtime_error("Failed to extract features from audio");
+  }
+
+  if (!vocabulary_) {
+    throw std::runtime_error("Vocabulary not loaded. This should not happen.");
+  }
+  // Language comes from the checkpoint: detecting it again could pick a different tokenizer
+  auto tokenizer = std::make_unique<Tokenizer>(*vocabulary_, model->is_multilingual(), checkpoint.task, checkpoint.language);
+
+  TranscriptionOptions options = default_transcription_options(checkpoint.multilingual, duration);
+
+  TranscriptionInfo info;
+  info.language = checkpoint.language;
+  info.language_probability = checkpoint.language_probability;
+  info.duration = duration;
+  info.transcription_options = options;
+
+  auto iterator = std::make_unique<SegmentIterator>(*this, std::move(features), std::move(tokenizer), checkpoint.task, options, info,
+                                                    TranscriptionCheckpoint::audio_digest(audio), deadline);
+  iterator->restore(checkpoint);
+  return iterator;
+}
+
+std::tuple<std::vector<Segment>, TranscriptionInfo> WhisperModel::transcribe_streaming(
+  const std::vector<float> &audio,
+  StreamingContext &context
+) {
+  float duration = static_cast<float>(audio.size()) / feature_extractor.sampling_rate();
+
+  auto features = feature_extractor.extract(audio);
+  if (features.empty() || features[0].empty()) {
+    throw std::runtime_error("Failed to extract features from audio");
+  }
+
+  return transcribe_streaming_features(features, duration, context);
+}
+
+std::tuple<std::vector<Segment>, TranscriptionInfo> WhisperModel::transcribe_streaming_features(
+  const std::vector<std::vector<float>> &features,
+  float duration,
+  StreamingContext &context
+) {
+  const size_t n_mels = feature_extractor.mel_filters.size();
+  if (features.size() != n_mels || features[0].empty()) {
+    throw std::invalid_argument("Streaming features must have " + std::to_string(n_mels) + " mel bins and at least one frame");
+  }
+
+  if (!context.tokenizer_) {
+    // A session restored from a snapshot keeps the language it had already resolved
+    if (!context.language_resolved_) {
+      auto [detected_language, language_probability, all_language_probs] = resolve_language(context.language_, features);
+      context.detected_language_ = detected_language;
+      context.language_probability_ = language_probability;
+    }
+    context.language_resolved_ = false;
+
+    if (!vocabulary_) {
+      throw std::runtime_error("Vocabulary not loaded. This should not happen.");
+    }
+    context.tokenizer_ = std::make_unique<Tokenizer>(*vocabulary_, model->is_multilingual(), context.task_, context.detected_language_);
+
+    // The session language is fixed once resolved, so skip the per-segment language detection
+    context.options_ = default_transcription_options(false, duration);
+    context.options_->prompt_reset_on_temperature = context.policy_.reset_on_temperature;
+  }
+
+  TranscriptionOptions options = *context.options_;
+  options.clip_timestamps = std::vector<float>{0.0f, duration};
+  if (!context.history().empty()) {
+    options.initial_prompt = context.history();
+  }
+
+  std::vector<Segment> segments = generate_segments(features, *context.tokenizer_, options);
+
+  TranscriptionInfo info;
+  info.language = context.detected_language_;
+  info.language_probability = context.language_probability_;
+  info.duration = duration;
+  info.transcription_options = options;
+
+  // A detection made on silence or noise is not worth keeping; try again on the next window
+  if (!context.language_ && context.language_probability_ < 0.5f) {
+    context.tokenizer_.reset();
+    context.options_.reset();
+  }
+
+  return std::make_tuple(segments, info);
+}
+
+std::tuple<std::vector<std::vector<Segment>>, TranscriptionInfo> WhisperModel::transcribe_stereo(
+  const std::vector<float> &left,
+  const std::vector<float> &right,
+  const std::optional<std::string> &language,
+  bool multilingual,
+  const std::string &task
+) {
+  if (multilingual && !model->is_multilingual()) {
+    std::cerr << "The current model is English-only but multilingual parameter is set to True; setting to False instead." << std::endl;
+    multilingual = false;
+  }
+
+  // Channels come from the same recording, so they share one timeline
+  size_t n_samples = std::max(left.size(), right.size());
+  float duration = static_cast<float>(n_samples) / feature_extractor.sampling_rate();
+
+  std::vector<std::vector<std::vector<float>>> features;
+  for (const auto *channel : {&left, &right}) {
+    std::vector<float> audio = *channel;
+    audio.resize(n_samples, 0.0f);
+    features.push_back(feature_extractor.extract(audio));
+    if (features.back().empty() || features.back()[0].empty()) {
+      throw std::runtime_error("Failed to extract features from audio");
+    }
+  }
+
+  std::cout << "#debug 🔄 Transcribing stereo " << std::fixed << std::setprecision(1) << duration << "s..." << std::endl;
+
+  // Both speakers are assumed to use the same language, detected on the first channel
+  auto [detected_language, language_probability, all_language_probs] = resolve_language(language, features[0]);
+
+  if (!vocabulary_) {
+    throw std::runtime_error("Vocabulary not loaded. This should not happen.");
+  }
+  Tokenizer tokenizer(*vocabulary_, model->is_multilingual(), task, detected_language);
+
+  TranscriptionOptions options = default_transcription_options(multilingual, duration);
+  std::vector<std::vector<Segment>> segments = generate_segments_batch(features, tokenizer, options);
+
+  TranscriptionInfo info;
+  info.language = detected_language;
+  info.language_probability = language_probability;
+  info.duration = duration;
+  info.transcription_options = options;
+  info.all_language_probs = all_language_probs;
+
+  return std::make_tuple(segments, info);
+}
+
+std::tuple<std::vector<AlignedSegment>, TranscriptionInfo> WhisperModel::align(
+  const std::vector<float> &audio,
+  const std::vector<AlignmentRequest> &requests,
+  const std::optional<std::string> &language,
+  const std::string &task
+) {
+  constexpr size_t alignment_batch_size = 8;  // Windows encoded and aligned together
+
+  float duration = static_cast<float>(audio.size()) / feature_extractor.sampling_rate();
+
+  auto features = feature_extractor.extract(audio);
+  if (features.empty() || features[0].empty()) {
+    throw std::runtime_error("Failed to extract features from audio");
+  }
+
+  auto [detected_language, language_probability, all_language_probs] = resolve_language(language, features);
+
+  if (!vocabulary_) {
+    throw std::runtime_error("Vocabulary not loaded. This should not happen.");
+  }
+  Tokenizer tokenizer(*vocabulary_, model->is_multilingual(), task, detected_language);
+
+  const int content_frames = static_cast<int>(features[0].size()) - 1;
+  const float window_seconds = feature_extractor.nb_max_frames() * feature_extractor.time_per_frame();
+  auto to_frame = [&](float seconds) {
+    return std::clamp(static_cast<int>(std::round(seconds / feature_extractor.time_per_frame())), 0, content_frames);
+  };
+
+  // A timed text gets its own window; a run of untimed texts shares the window that follows
+  // the previous timed text, up to the next timed text
+  struct AlignmentWindow {
+    int seek;
+    int num_frames;
+    bool timed;
+    std::vector<size_t> requests;
+  };
+  std::vector<AlignmentWindow> windows;
+  float cursor = 0.0f;
+  for (size_t i = 0; i < requests.size(); ++i) {
+    const auto &request = requests[i];
+    if (request.start.has_value()) {
+      float start = std::clamp(*request.start, 0.0f, duration);
+      float end = std::clamp(request.end.value_or(start + window_seconds), start, duration);
+      int seek = to_frame(start);
+      windows.push_back({seek, std::min(to_frame(end) - seek, feature_extractor.nb_max_frames()), true, {i}});
+      cursor = end;
+    } else {
+      if (windows.empty() || windows.back().timed) {
+        float end = duration;
+        for (size_t j = i + 1; j < requests.size(); ++j) {
+          if (requests[j].start.has_value()) {
+            end = std::clamp(*requests[j].start, cursor, duration);
+            break;
+          }
+        }
+        int seek = to_frame(cursor);
+        windows.push_back({seek, std::min(to_frame(end) - seek, feature_extractor.nb_max_frames()), false, {}});
+      }
+      windows.back().requests.push_back(i);
+    }
+  }
+
+  std::vector<AlignedSegment> aligned(requests.size());
+  for (size_t i = 0; i < requests.size(); ++i) {
+    aligned[i].text = requests[i].text;
+  }
+
+  // Texts of a window are aligned as one token sequence; token_counts maps the words back to each text
+  std::vector<std::vector<int>> window_tokens(windows.size());
+  std::vector<std::vector<size_t>> token_counts(windows.size());
+  for (size_t w = 0; w < windows.size(); ++w) {
+    for (size_t request_idx : windows[w].requests) {
+      const std::string &text = requests[request_idx].text;
+      size_t first = text.find_first_not_of(" \t\n");
+      std::vector<int> tokens;
+      if (first != std::string::npos) {
+        tokens = tokenizer.encode(" " + text.substr(first));
+      }
+      token_counts[w].push_back(tokens.size());
+      window_tokens[w].insert(window_tokens[w].end(), tokens.begin(), tokens.end());
+    }
+  }
+
+  for (size_t batch_start = 0; batch_start < windows.size(); batch_start += alignment_batch_size) {
+    std::vector<size_t> batch;
+    std::vector<std::vector<std::vector<float>>> batch_features;
+    std::vector<std::vector<int>> text_tokens;
+    std::vector<int> num_frames;
+    for (size_t w = batch_start; w < std::min(batch_start + alignment_batch_size, windows.size()); ++w) {
+      if (windows[w].num_frames <= 0 || window_tokens[w].empty()) {
+        continue;
+      }
+      batch.push_back(w);
+      batch_features.push_back(pad_or_trim(slice_features(features, windows[w].seek, windows[w].num_frames)));
+      text_tokens.push_back(window_tokens[w]);
+      num_frames.push_back(windows[w].num_frames);
+    }
+    if (batch.empty()) {
+      continue;
+    }
+
+    ctranslate2::StorageView encoder_output = encode_batch(batch_features);
+    auto alignments = find_alignment(tokenizer, text_tokens, encoder_output, num_frames);
+
+    for (size_t b = 0; b < batch.size(); ++b) {
+      const auto &window = windows[batch[b]];
+      auto &alignment = alignments[b];
+      float time_offset = window.seek * feature_extractor.time_per_frame();
+      size_t word_index = 0;
+
+      for (size_t r = 0; r < window.requests.size(); ++r) {
+        auto &segment = aligned[window.requests[r]];
+        size_t saved_tokens = 0;
+        while (word_index < alignment.size() && saved_tokens < token_counts[batch[b]][r]) {
+          auto &timing = alignment[word_index];
+          auto word = std::any_cast<std::string>(timing["word"]);
+          if (!word.empty()) {
+            segment.words.push_back({
+              std::round((time_offset + std::any_cast<float>(timing["start"])) * 100) / 100,
+              std::round((time_offset + std::any_cast<float>(timing["end"])) * 100) / 100,
+              word,
+              std::any_cast<float>(timing["probability"])
+            });
+          }
+          saved_tokens += std::any_cast<std::vector<int>>(timing["tokens"]).size();
+          word_index++;
+        }
+      }
+    }
+  }
+
+  // Texts without words (empty, or outside the audio) keep the start of their window
+  for (size_t w = 0; w < windows.size(); ++w) {
+    float window_start = windows[w].seek * feature_extractor.time_per_frame();
+    for (size_t request_idx : windows[w].requests) {
+      auto &segment = aligned[request_idx];
+      segment.start = segment.words.empty() ? window_start : segment.words.front().start;
+      segment.end = segment.words.empty() ? window_start : segment.words.back().end;
+    }
+  }
+
+  TranscriptionInfo info;
+  info.language = detected_language;
+  info.language_probability = language_probability;
+  info.duration = duration;
+  info.transcription_options = default_transcription_options(false, duration);
+  info.all_language_probs = all_language_probs;
+
+  return std::make_tuple(aligned, info);
+}
+
+std::tuple<std::string, float, std::vector<std::pair<std::string, float>>> WhisperModel::resolve_language(
+  const std::optional<std::string> &language,
+  const std::vector<std::vector<float>> &features
+) {
   std::string detected_language;
   float language_probability = 1.0f;
   std::vector<std::pair<std::string, float>> all_language_probs;
@@ -311,43 +990,10 @@ std::tuple<std::vector<Segment>, TranscriptionInfo> WhisperModel::transcribe(
     language_probability = 1;
   }
 
-  // Step 5: Use cached vocabulary for tokenizer initialization
-  if (!vocabulary_) {
-    throw std::runtime_error("Vocabulary not loaded. This should not happen.");
-  }
-
-  const ctranslate2::Vocabulary& vocabulary = *vocabulary_;
-
-  // Use the CTranslate2 vocabulary to create the tokenizer
-  Tokenizer tokenizer(vocabulary, model->is_multilingual(), task, detected_language);
-
-  // Debug tokenizer initialization
-  // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "🧪 Testing tokenizer methods...");
-
-  try {
-    int sot = tokenizer.get_sot();
-    int sot_prev = tokenizer.get_sot_prev();
-    int eot = tokenizer.get_eot();
-    int transcribe_token = tokenizer.get_transcribe();
-    auto sot_seq = tokenizer.get_sot_sequence();
-
-    // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "SOT token: %d", sot);
-    // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "SOT_PREV token: %d", sot_prev);
-    // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "EOT token: %d", eot);
-    // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "TRANSCRIBE token: %d", transcribe_token);
-    // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "SOT sequence length: %zu", sot_seq.size());
-
-    // std::string sot_seq_str = "SOT sequence: ";
-    // for (size_t i = 0; i < sot_seq.size(); ++i) {
-    //   sot_seq_str += std::to_string(sot_seq[i]);
-    //   if (i < sot_seq.size() - 1) sot_seq_str += ", ";
-    // }
-    // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "%s", sot_seq_str.c_str());
-  } catch (const std::exception& e) {
-    // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "Error testing tokenizer methods: %s", e.what());
-  }
+  return {detected_language, language_probability, all_language_probs};
+}
 
-  // Step 6: Set up transcription options (Python line 956-989)
+TranscriptionOptions WhisperModel::default_transcription_options(bool multilingual, float duration) const {
   TranscriptionOptions options;
   options.beam_size = 5;
   options.best_of = 5;
@@ -372,6 +1018,8 @@ std::tuple<std::vector<Segment>, TranscriptionInfo> WhisperModel::transcribe(
   options.append_punctuations = "\"\'.。，！？：\")}]、";
   options.multilingual = multilingual;
   options.max_new_tokens = std::nullopt;
+  const float token_budget = token_budget_.load(std::memory_order_relaxed);
+  options.max_tokens_per_second = token_budget > 0.0f ? std::optional<float>(token_budget) : std::nullopt;
 
   // For short segments, don't use overlapping windows - just process the full duration
   std::vector<float> overlapping_timestamps;
@@ -382,18 +1030,18 @@ std::tuple<std::vector<Segment>, TranscriptionInfo> WhisperModel::transcribe(
   options.hallucination_silence_threshold = std::nullopt;
   options.hotwords = std::nullopt;
 
-  // Step 7: Generate segments using the same logic as Python (line 991-993)
-  std::vector<Segment> segments = generate_segments(features, tokenizer, options);
-
-  // Step 8: Create transcription info (Python line 998-1006)
-  TranscriptionInfo info;
-  info.language = detected_language;
-  info.language_probability = language_probability;
-  info.duration = duration;
-  info.transcription_options = options;
-  info.all_language_probs = all_language_probs;
+  return options;
+}
 
-  return std::make_tuple(segments, info);
+TranscriptionOptions WhisperModel::draft_transcription_options(float duration) const {
+  // One greedy attempt per window with no prompt history: no beam, no temperature fallback
+  TranscriptionOptions options = default_transcription_options(false, duration);
+  options.beam_size = 1;
+  options.best_of = 1;
+  options.temperatures = {0.0f};
+  options.condition_on_previous_text = false;
+  options.word_timestamps = false;
+  return options;
 }
 
 std::vector<Word> WhisperModel::generate_word_timestamps(
@@ -630,14 +1278,14 @@ std::tuple<std::vector<Segment>, int, bool> WhisperModel::split_segments_by_time
   return {current_segments, seek, single_timestamp_ending};
 }
 
-std::vector<Segment> WhisperModel::generate_segments(
+SegmentGenerationState WhisperModel::begin_segments(
   const std::vector<std::vector<float>> &features,
   Tokenizer &tokenizer,
   const TranscriptionOptions &options
 ) {
   // Follow Python implementation logic from line 1089-1375
+  SegmentGenerationState state;
   int content_frames = static_cast<int>(features[0].size()) - 1;
-  float content_duration = content_frames * feature_extractor.time_per_frame();
 
   // Parse clip_timestamps like Python (line 1100-1108)
   std::vector<float> clip_timestamps_vec;
@@ -661,198 +1309,293 @@ std::vector<Segment> WhisperModel::generate_segments(
   }
 
   // Create seek clips (Python line 1117-1119)
-  std::vector<std::pair<int, int>> seek_clips;
   for (size_t i = 0; i < seek_points.size(); i += 2) {
-    seek_clips.emplace_back(seek_points[i], seek_points[i + 1]);
+    state.seek_clips.emplace_back(seek_points[i], seek_points[i + 1]);
   }
-
-  std::vector<Segment> all_segments;
-  int idx = 0;
-  int clip_idx = 0;
-  int seek = seek_clips[clip_idx].first;
-  std::vector<int> all_tokens;
-  int prompt_reset_since = 0;
+  state.seek = state.seek_clips[0].first;
 
   // Handle initial prompt (Python line 1129-1135)
   if (options.initial_prompt.has_value()) {
     if (std::holds_alternative<std::string>(options.initial_prompt.value())) {
       std::string initial_prompt = " " + std::get<std::string>(options.initial_prompt.value());
       std::vector<int> initial_tokens = tokenizer.encode(initial_prompt);
-      all_tokens.insert(all_tokens.end(), initial_tokens.begin(), initial_tokens.end());
+      state.all_tokens.insert(state.all_tokens.end(), initial_tokens.begin(), initial_tokens.end());
     } else if (std::holds_alternative<std::vector<int>>(options.initial_prompt.value())) {
       auto initial_tokens = std::get<std::vector<int>>(options.initial_prompt.value());
-      all_tokens.insert(all_tokens.end(), initial_tokens.begin(), initial_tokens.end());
+      state.all_tokens.insert(state.all_tokens.end(), initial_tokens.begin(), initial_tokens.end());
     }
   }
 
-  float last_speech_timestamp = 0.0f;
-  ctranslate2::StorageView encoder_output;
+  return state;
+}
 
-  // Main transcription loop (Python line 1143-1375)
-  //logTranscribeTimestamp("Transcription completed, processing segments...");
-  while (clip_idx < seek_clips.size()) {
-    auto [seek_clip_start, seek_clip_end] = seek_clips[clip_idx];
-    if (seek_clip_end > content_frames) {
-      seek_clip_end = content_frames;
+int WhisperModel::advance_seek_clip(SegmentGenerationState &state, int content_frames) {
+  // Move to the next clip when the current one is done (Python line 1144-1156)
+  int seek_clip_end = 0;
+  while (!state.finished) {
+    if (state.clip_idx >= state.seek_clips.size()) {
+      state.finished = true;
+      break;
     }
-    if (seek < seek_clip_start) {
-      seek = seek_clip_start;
+    auto [seek_clip_start, clip_end] = state.seek_clips[state.clip_idx];
+    seek_clip_end = std::min(clip_end, content_frames);
+    if (state.seek < seek_clip_start) {
+      state.seek = seek_clip_start;
     }
-    if (seek >= seek_clip_end) {
-      clip_idx++;
-      if (clip_idx < seek_clips.size()) {
-        seek = seek_clips[clip_idx].first;
-      }
-      continue;
+    if (state.seek < seek_clip_end) {
+      break;
     }
-
-    float time_offset = seek * feature_extractor.time_per_frame();
-    int segment_size = std::min({
-      feature_extractor.nb_max_frames(),
-      content_frames - seek,
-      seek_clip_end - seek
-    });
-
-    // Extract and pad segment (Python line 1164-1166)
-    auto segment_features = slice_features(features, seek, segment_size);
-    segment_features = pad_or_trim(segment_features);
-    float segment_duration = segment_size * feature_extractor.time_per_frame();
-
-    // Get previous tokens for prompt (Python line 1173)
-    std::vector<int> previous_tokens(all_tokens.begin() + prompt_reset_since, all_tokens.end());
-    // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "previous_tokens.size(): %zu", previous_tokens.size());
-
-    // Encode segment if needed (Python line 1175-1176)
-    // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "Checking if encoding needed: seek=%d, encoder_output.empty()=%d",
-    //                     seek, encoder_output.empty());
-    if (seek > 0 || encoder_output.empty()) {
-      //logTranscribeTimestamp("Starting encoder");
-      encoder_output = encode(segment_features);
-      //logTranscribeTimestamp("Encoder completed");
-    } else {
-      // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "Reusing existing encoder_output");
+    state.clip_idx++;
+    if (state.clip_idx < state.seek_clips.size()) {
+      state.seek = state.seek_clips[state.clip_idx].first;
     }
+  }
+  return seek_clip_end;
+}
 
-    // Language detection per segment if multilingual (Python line 1178-1184)
-    if (options.multilingual && model->is_multilingual()) {
-      auto results_future = model->detect_language(encoder_output);
-      auto results = results_future[0].get(); // Get result from first future in vector
-      if (!results.empty()) {
-        std::string language_token = results[0].first;
-        // Extract language code (Python line 1181: language = language_token[2:-2])
-        if (language_token.length() > 4) {
-          std::string language = language_token.substr(2, language_token.length() - 4);
-          // Update tokenizer language (Python line 1183-1184)
-          // This would require tokenizer API extensions
-        }
+std::vector<Segment> WhisperModel::generate_next_segments(
+  const std::vector<std::vector<float>> &features,
+  Tokenizer &tokenizer,
+  const TranscriptionOptions &options,
+  SegmentGenerationState &state,
+  const std::function<void(const EncoderWindow &)> &on_encoder_output
+) {
+  int content_frames = static_cast<int>(features[0].size()) - 1;
+
+  int seek_clip_end = advance_seek_clip(state, content_frames);
+  if (state.finished) {
+    return {};
+  }
+
+  int seek = state.seek;
+  float time_offset = seek * feature_extractor.time_per_frame();
+  int segment_size = std::min({
+    feature_extractor.nb_max_frames(),
+    content_frames - seek,
+    seek_clip_end - seek
+  });
+
+  // Extract and pad segment (Python line 1164-1166)
+  auto segment_features = slice_features(features, seek, segment_size);
+  segment_features = pad_or_trim(segment_features);
+  float segment_duration = segment_size * feature_extractor.time_per_frame();
+
+  // Get previous tokens for prompt (Python line 1173)
+  std::vector<int> previous_tokens(state.all_tokens.begin() + state.prompt_reset_since, state.all_tokens.end());
+
+  // Encode segment (Python line 1175-1176)
+  ctranslate2::StorageView encoder_output = encode(segment_features);
+
+  if (on_encoder_output) {
+    on_encoder_output({0, time_offset, time_offset + segment_duration,
+                       static_cast<size_t>((segment_size + input_stride - 1) / input_stride), &encoder_output});
+  }
+
+  // Language detection per segment if multilingual (Python line 1178-1184)
+  if (options.multilingual && model->is_multilingual()) {
+    auto results_future = model->detect_language(encoder_output);
+    auto results = results_future[0].get(); // Get result from first future in vector
+    if (!results.empty()) {
+      std::string language_token = results[0].first;
+      // Extract language code (Python line 1181: language = language_token[2:-2])
+      if (language_token.length() > 4) {
+        std::string language = language_token.substr(2, language_token.length() - 4);
+        // Update tokenizer language (Python line 1183-1184)
+        // This would require tokenizer API extensions
       }
     }
+  }
 
-    // Get prompt (Python line 1186-1192)
-    std::vector<int> prompt = get_prompt(
-      tokenizer,
-      previous_tokens,
-      options.without_timestamps,
-      (seek == 0) ? options.prefix : std::nullopt,
-      options.hotwords
-    );
-
-    // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "get_prompt returned prompt.size(): %zu", prompt.size());
+  // Get prompt (Python line 1186-1192)
+  std::vector<int> prompt = get_prompt(
+    tokenizer,
+    previous_tokens,
+    options.without_timestamps,
+    (seek == 0) ? options.prefix : std::nullopt,
+    options.hotwords
+  );
 
-    // Generate with fallback (Python line 1194-1199)
-    //logTranscribeTimestamp("Starting generate_with_fallback");
+  // Generate with fallback (Python line 1194-1199)
+  auto [result, avg_logprob, temperature, compression_ratio] = generate_with_fallback(
+    encoder_output, prompt, tokenizer, options, segment_duration
+  );
 
-    auto [result, avg_logprob, temperature, compression_ratio] = generate_with_fallback(
-      encoder_output, prompt, tokenizer, options
-    );
+  // No speech detection (Python line 1201-1221)
+  if (options.no_speech_threshold.has_value()) {
+    // This requires access to result.no_speech_prob from CTranslate2
+    // For now, skip this check
+  }
 
-    // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "generate_with_fallback completed successfully");
-    // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "Generated %zu tokens", result.size());
+  std::vector<int> tokens = result;
+  int previous_seek = seek;
 
-    // Debug: Show first few generated tokens
-    // if (!result.empty()) {
-    //   std::string tokens_str = "Generated tokens: ";
-    //   for (size_t i = 0; i < std::min(result.size(), size_t(10)); ++i) {
-    //     tokens_str += std::to_string(result[i]) + " ";
-    //   }
-    //   __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "%s", tokens_str.c_str());
+  // Split segments by timestamps (Python line 1251-1262)
+  auto [current_segments, new_seek, single_timestamp_ending] = split_segments_by_timestamps(
+    tokenizer, tokens, time_offset, segment_size, segment_duration, seek
+  );
+  state.seek = new_seek;
 
-    //   // Try to decode the result
-    //   std::string decoded_result = tokenizer.decode(result);
-    //   __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "Decoded result: '%s'", decoded_result.c_str());
-    // }
+  // Process current segments (Python line 1330-1356)
+  std::vector<Segment> segments;
+  for (auto& segment : current_segments) {
+    std::string text = tokenizer.decode(segment.tokens);
 
-    // No speech detection (Python line 1201-1221)
-    if (options.no_speech_threshold.has_value()) {
-      // This requires access to result.no_speech_prob from CTranslate2
-      // For now, skip this check
+    if (segment.start == segment.end || text.empty()) {
+      continue;
     }
 
-    std::vector<int> tokens = result;
-    int previous_seek = seek;
+    state.all_tokens.insert(state.all_tokens.end(), segment.tokens.begin(), segment.tokens.end());
+    state.idx++;
 
-    // Split segments by timestamps (Python line 1251-1262)
-    auto [current_segments, new_seek, single_timestamp_ending] = split_segments_by_timestamps(
-      tokenizer, tokens, time_offset, segment_size, segment_duration, seek
-    );
-    seek = new_seek;
+    // Create segment object
+    Segment seg;
+    seg.id = state.idx;
+    seg.seek = previous_seek;
+    seg.start = segment.start;
+    seg.end = segment.end;
+    seg.text = text;
+    seg.tokens = segment.tokens;
+    seg.temperature = temperature;
+    seg.avg_logprob = avg_logprob;
+    seg.compression_ratio = compression_ratio;
+    seg.no_speech_prob = 0.0f; // Would need CTranslate2 result
+    seg.words = std::nullopt; // Word timestamps handled separately
 
-    // Process current segments (Python line 1330-1356)
-    // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "Processing %zu segments", current_segments.size());
-    for (auto& segment : current_segments) {
-      // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "About to decode segment with %zu tokens...", segment.tokens.size());
+    segments.push_back(seg);
+  }
 
-      // Log the tokens before decoding
-      // std::string tokens_debug = "Segment tokens: ";
-      // for (size_t i = 0; i < std::min(segment.tokens.size(), size_t(20)); ++i) {
-      //   tokens_debug += std::to_string(segment.tokens[i]) + " ";
-      // }
-      // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "%s", tokens_debug.c_str());
+  // Prompt reset logic (Python line 1358-1369)
+  if (!options.condition_on_previous_text || temperature > options.prompt_reset_on_temperature) {
+    state.prompt_reset_since = static_cast<int>(state.all_tokens.size());
+  }
+
+  return segments;
+}
 
-      std::string text = tokenizer.decode(segment.tokens);
-      // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "✅ Segment decode completed! Text: '%s' (tokens: %zu)", text.c_str(), segment.tokens.size());
+std::vector<Segment> WhisperModel::generate_segments(
+  const std::vector<std::vector<float>> &features,
+  Tokenizer &tokenizer,
+  const TranscriptionOptions &options,
+  const std::function<void(const EncoderWindow &)> &on_encoder_output
+) {
+  std::vector<Segment> all_segments;
+  SegmentGenerationState state = begin_segments(features, tokenizer, options);
 
-      if (segment.start == segment.end || text.empty()) {
-        // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "Skipping empty segment");
-        continue;
+  // Main transcription loop (Python line 1143-1375), one seek window per call
+  while (!state.finished) {
+    auto segments = generate_next_segments(features, tokenizer, options, state, on_encoder_output);
+    all_segments.insert(all_segments.end(), segments.begin(), segments.end());
+  }
+
+  return all_segments;
+}
+
+std::vector<std::vector<Segment>> WhisperModel::generate_segments_batch(
+  const std::vector<std::vector<std::vector<float>>> &features,
+  Tokenizer &tokenizer,
+  const TranscriptionOptions &options,
+  const std::function<void(const EncoderWindow &)> &on_encoder_output
+) {
+  // Same seek loop as generate_segments, run in lockstep over every input.
+  // Inputs still in progress are encoded and decoded together as one batch.
+  const size_t batch_size = features.size();
+  std::vector<int> content_frames(batch_size);
+  std::vector<int> clip_ends(batch_size, 0);
+  std::vector<SegmentGenerationState> states;
+  std::vector<std::vector<Segment>> all_segments(batch_size);
+
+  for (size_t b = 0; b < batch_size; ++b) {
+    content_frames[b] = static_cast<int>(features[b][0].size()) - 1;
+    states.push_back(begin_segments(features[b], tokenizer, options));
+  }
+
+  while (true) {
+    std::vector<size_t> active;
+    for (size_t b = 0; b < batch_size; ++b) {
+      clip_ends[b] = advance_seek_clip(states[b], content_frames[b]);
+      if (!states[b].finished) {
+        active.push_back(b);
       }
+    }
+    if (active.empty()) {
+      break;
+    }
 
-      all_tokens.insert(all_tokens.end(), segment.tokens.begin(), segment.tokens.end());
-      idx++;
-
-      // Create segment object
-      Segment seg;
-      seg.id = idx;
-      seg.seek = previous_seek;
-      seg.start = segment.start;
-      seg.end = segment.end;
-      seg.text = text;
-      seg.tokens = segment.tokens;
-      seg.temperature = temperature;
-      seg.avg_logprob = avg_logprob;
-      seg.compression_ratio = compression_ratio;
-      seg.no_speech_prob = 0.0f; // Would need CTranslate2 result
-      seg.words = std::nullopt; // Word timestamps handled separately
-
-      all_segments.push_back(seg);
-
-      // Output from within generate_segments is commented out to avoid duplicate logging
-      // The actual results will be logged from the transcribe() function
-      //std::cout << "]" << std::endl;
-      //std::cout << "[" << std::fixed << std::setprecision(2) << segment.start << "s -> " << segment.end << "s]" << std::endl;
-      //std::cout << text << std::endl;
+    std::vector<std::vector<std::vector<float>>> batch_features;
+    std::vector<std::vector<int>> prompts;
+    std::vector<int> segment_sizes;
+    for (size_t b : active) {
+      const SegmentGenerationState &state = states[b];
+      int segment_size = std::min({
+        feature_extractor.nb_max_frames(),
+        content_frames[b] - state.seek,
+        clip_ends[b] - state.seek
+      });
+      segment_sizes.push_back(segment_size);
+      batch_features.push_back(pad_or_trim(slice_features(features[b], state.seek, segment_size)));
+
+      std::vector<int> previous_tokens(state.all_tokens.begin() + state.prompt_reset_since, state.all_tokens.end());
+      prompts.push_back(get_prompt(
+        tokenizer,
+        previous_tokens,
+        options.without_timestamps,
+        (state.seek == 0) ? options.prefix : std::nullopt,
+        options.hotwords
+      ));
     }
 
-    // Prompt reset logic (Python line 1358-1369)
-    if (!options.condition_on_previous_text || temperature > options.prompt_reset_on_temperature) {
-      prompt_reset_since = static_cast<int>(all_tokens.size());
+    auto encoder_output = encode_batch(batch_features);
+    if (on_encoder_output) {
+      for (size_t i = 0; i < active.size(); ++i) {
+        float window_start = states[active[i]].seek * feature_extractor.time_per_frame();
+        on_encoder_output({i, window_start, window_start + segment_sizes[i] * feature_extractor.time_per_frame(),
+                           static_cast<size_t>((segment_sizes[i] + input_stride - 1) / input_stride), &encoder_output});
+      }
     }
-  }
+    float longest_window = *std::max_element(segment_sizes.begin(), segment_sizes.end()) * feature_extractor.time_per_frame();
+    auto results = generate_with_fallback_batch(encoder_output, prompts, tokenizer, options, longest_window);
+
+    for (size_t i = 0; i < active.size(); ++i) {
+      size_t b = active[i];
+      SegmentGenerationState &state = states[b];
+      auto [tokens, avg_logprob, temperature, compression_ratio] = results[i];
+      int previous_seek = state.seek;
+      float time_offset = previous_seek * feature_extractor.time_per_frame();
+      float segment_duration = segment_sizes[i] * feature_extractor.time_per_frame();
+
+      auto [current_segments, new_seek, single_timestamp_ending] = split_segments_by_timestamps(
+        tokenizer, tokens, time_offset, segment_sizes[i], segment_duration, previous_seek
+      );
+      state.seek = new_seek;
 
-  // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "generate_segments completed with %zu segments", all_segments.size());
-  // for (size_t i = 0; i < all_segments.size(); ++i) {
-  //   __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "Final segment %zu: '%s'", i, all_segments[i].text.c_str());
-  // }
+      for (auto &segment : current_segments) {
+        std::string text = tokenizer.decode(segment.tokens);
+        if (segment.start == segment.end || text.empty()) {
+          continue;
+        }
+
+        state.all_tokens.insert(state.all_tokens.end(), segment.tokens.begin(), segment.tokens.end());
+
+        Segment seg;
+        seg.id = ++state.idx;
+        seg.seek = previous_seek;
+        seg.start = segment.start;
+        seg.end = segment.end;
+        seg.text = text;
+        seg.tokens = segment.tokens;
+        seg.temperature = temperature;
+        seg.avg_logprob = avg_logprob;
+        seg.compression_ratio = compression_ratio;
+        seg.no_speech_prob = 0.0f;
+        seg.words = std::nullopt;
+        all_segments[b].push_back(seg);
+      }
+
+      if (!options.condition_on_previous_text || temperature > options.prompt_reset_on_temperature) {
+        state.prompt_reset_since = static_cast<int>(state.all_tokens.size());
+      }
+    }
+  }
 
   return all_segments;
 }
@@ -861,51 +1604,173 @@ std::vector<Segment> WhisperModel::generate_segments(
 // Encode features using the Whisper model
 // --------------------------
 ctranslate2::StorageView WhisperModel::encode(const std::vector<std::vector<float>> &features) {
+  return encode_batch({features});
+}
+
+ctranslate2::StorageView WhisperModel::encode_batch(const std::vector<std::vector<std::vector<float>>> &batch) {
   // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "=== ENTERING encode() ===");
-  // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "Features dimensions: %zu x %zu", features.size(),
-  //                     features.empty() ? 0 : features[0].size());
 
   bool to_cpu = false; // Simplified for CPU-only build
 
   // CTranslate2 Whisper model expects 3D input: [batch_size, n_mels, n_frames]
-  // Input features are 2D: [n_mels, n_frames], so we need to add batch dimension
+  // Each input is 2D: [n_mels, n_frames], all inputs must have the same shape
 
-  if (features.empty() || features[0].empty()) {
+  if (batch.empty() || batch[0].empty() || batch[0][0].empty()) {
     __android_log_print(ANDROID_LOG_ERROR, "#transcribe", "encode() called with empty features!");
     throw std::runtime_error("Cannot encode empty features");
   }
 
   // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "Creating 3D storage tensor...");
-  // Create 3D tensor by adding batch dimension
-  auto storage = get_ctranslate2_storage_3d(features);
-  // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "Storage created with shape: [%lld, %lld, %lld]",
-  //                     (long long)storage.shape()[0], (long long)storage.shape()[1], (long long)storage.shape()[2]);
+  // Create 3D tensor staged in a cached block and viewed (not copied) by the StorageView
+  const size_t batch_size = batch.size();
+  const size_t n_mels = batch[0].size();
+  const size_t n_frames = batch[0][0].size();
+  for (const auto &features : batch) {
+    if (features.size() != n_mels || features[0].size() != n_frames) {
+      throw std::runtime_error("Cannot encode a batch of features with different shapes");
+    }
+  }
+  std::unique_ptr<float, std::function<void(float*)>> staging(
+    static_cast<float*>(tensor_allocator_.allocate(batch_size * n_mels * n_frames * sizeof(float))),
+    [this](float* ptr) { tensor_allocator_.free(ptr); }
+  );
+  for (size_t b = 0; b < batch_size; ++b) {
+    float* dst = staging.get() + b * n_mels * n_frames;
+    for (size_t mel = 0; mel < n_mels; ++mel) {
+      std::copy(batch[b][mel].begin(), batch[b][mel].end(), dst + mel * n_frames);
+    }
+  }
+  ctranslate2::StorageView storage(
+    {static_cast<ctranslate2::dim_t>(batch_size), static_cast<ctranslate2::dim_t>(n_mels), static_cast<ctranslate2::dim_t>(n_frames)},
+    staging.get()
+  );
 
-  // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "Calling model->encode()...");
   try {
     auto future = model->encode(storage, to_cpu);
-    // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "model->encode() returned future, getting result...");
-
-    auto result = future.get();
-    // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "encode() completed successfully!");
-    // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "=== EXITING encode() ===");
-    return result;
-
+    return future.get();
   } catch (const std::exception& e) {
     __android_log_print(ANDROID_LOG_ERROR, "#transcribe", "EXCEPTION in model->encode(): %s", e.what());
     throw;
   }
 }
 
+void WhisperModel::set_token_budget(float tokens_per_second) {
+  if (!(tokens_per_second >= 0.0f)) {
+    throw std::invalid_argument("Token budget must not be negative, got " + std::to_string(tokens_per_second));
+  }
+  token_budget_.store(tokens_per_second, std::memory_order_relaxed);
+}
+
+void WhisperModel::set_time_compression(float factor) {
+  if (!(factor >= 1.0f && factor <= 2.0f)) {
+    throw std::invalid_argument("Time compression factor must be between 1 and 2, got " + std::to_string(factor));
+  }
+  time_compression_ = factor;
+}
+
+std::vector<float> WhisperModel::pool_encoder_output(const EncoderWindow &window) {
+  // Half-precision or device outputs are converted; float32 CPU outputs are read in place
+  const ctranslate2::StorageView *output = window.output;
+  ctranslate2::StorageView converted;
+  if (output->device() != ctranslate2::Device::CPU || output->dtype() != ctranslate2::DataType::FLOAT32) {
+    converted = output->to(ctranslate2::Device::CPU).to_float32();
+    output = &converted;
+  }
+
+  const size_t positions = static_cast<size_t>(output->dim(1));
+  const size_t d_model = static_cast<size_t>(output->dim(2));
+  const size_t count = std::max<size_t>(1, std::min(window.content_positions, positions));
+  const float *row = output->data<float>() + window.batch_index * positions * d_model;
+
+  std::vector<float> pooled(d_model, 0.0f);
+  for (size_t t = 0; t < count; ++t) {
+    const float *position = row + t * d_model;
+    for (size_t d = 0; d < d_model; ++d) {
+      pooled[d] += position[d];
+    }
+  }
+  for (float &value : pooled) {
+    value /= static_cast<float>(count);
+  }
+  return pooled;
+}
+
+CachingAllocator::Stats WhisperModel::allocator_stats() const {
+  return tensor_allocator_.stats();
+}
+
+float WhisperModel::max_input_seconds() const {
+  return static_cast<float>(feature_extractor.n_samples) / feature_extractor.sampling_rate();
+}
+
+// --------------------------
+// Decoding options for one temperature of the fallback loop
+// --------------------------
+static ctranslate2::models::WhisperOptions make_whisper_options(
+  const TranscriptionOptions &options,
+  float temperature,
+  int max_length,
+  int max_initial_timestamp_index
+) {
+  ctranslate2::models::WhisperOptions whisper_options;
+
+  // Use proper beam search like Python faster-whisper
+  whisper_options.beam_size = options.beam_size;  // Use configured beam size (5)
+  whisper_options.patience = options.patience;    // Beam search patience for early stopping
+  whisper_options.num_hypotheses = 1;  // Single best hypothesis
+  if (temperature == 0.0f) {
+    // Greedy search - no sampling
+    whisper_options.sampling_topk = 1;  // Greedy
+    whisper_options.sampling_temperature = 1.0f;  // No effect in greedy
+  } else {
+    // Sampling with temperature
+    whisper_options.sampling_topk = 0;  // No top-k restriction
+    whisper_options.sampling_temperature = temperature;  // Use sampling temperature
+  }
+
+  whisper_options.length_penalty = options.length_penalty;
+  whisper_options.repetition_penalty = options.repetition_penalty;
+  whisper_options.no_repeat_ngram_size = options.no_repeat_ngram_size;
+  whisper_options.max_length = max_length;
+  whisper_options.suppress_blank = options.suppress_blank;
+  whisper_options.max_initial_timestamp_index = max_initial_timestamp_index;
+
+  if (options.suppress_tokens.has_value()) {
+    // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "Setting suppress_tokens...");
+    std::vector<int> suppress_tokens_int;
+    for (int token : options.suppress_tokens.value()) {
+      suppress_tokens_int.push_back(token);
+    }
+    whisper_options.suppress_tokens = suppress_tokens_int;
+    // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "suppress_tokens set with %zu tokens", suppress_tokens_int.size());
+  }
+
+  return whisper_options;
+}
+
 // --------------------------
 // Generate with fallback loop over temperatures
 // --------------------------
+// Token budget for one attempt on a window of the given duration
+// CTranslate2 runs an attempt to completion (there is no per-step callback for Whisper), so capping its
+// length is the earliest a repetition loop can be cut off: real speech stays well under the budget,
+// while a loop would otherwise run to max_length before the compression check rejects it
+static std::optional<int> window_token_budget(const TranscriptionOptions &options, std::optional<float> segment_duration) {
+  if (options.max_new_tokens.has_value() || !options.max_tokens_per_second.has_value() ||
+      *options.max_tokens_per_second <= 0.0f || !segment_duration.has_value()) {
+    return std::nullopt;
+  }
+  constexpr int slack_tokens = 32;  // SOT/timestamp tokens and very short windows
+  return static_cast<int>(std::ceil(*segment_duration * *options.max_tokens_per_second)) + slack_tokens;
+}
+
 std::tuple<std::vector<int>, float, float, float>
 WhisperModel::generate_with_fallback(
   const ctranslate2::StorageView &encoder_output,
   const std::vector<int> &prompt,
   Tokenizer &tokenizer,
-  const TranscriptionOptions &options
+  const TranscriptionOptions &options,
+  std::optional<float> segment_duration
 ) {
   // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "=== ENTERING generate_with_fallback ===");
   // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "Encoder output shape: [%lld, %lld, %lld]",
@@ -934,6 +1799,15 @@ WhisperModel::generate_with_fallback(
     throw std::runtime_error("Prompt + max_new_tokens exceeds Whisper max_length");
   }
 
+  // Cap each attempt at the window's token budget so a runaway attempt ends early
+  // Only a cut made by the budget marks a hypothesis as runaway, not a user max_new_tokens
+  auto token_budget = window_token_budget(options, segment_duration);
+  bool length_capped = false;
+  if (token_budget.has_value() && static_cast<int>(prompt.size()) + *token_budget < max_length) {
+    max_length = static_cast<int>(prompt.size()) + *token_budget;
+    length_capped = true;
+  }
+
   // Iterate through temperatures (Python line 1418)
   // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "Starting temperature loop...");
 
@@ -944,38 +1818,9 @@ WhisperModel::generate_with_fallback(
 
     // Configure generation options based on temperature (Python line 1419-1430)
     // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "Configuring whisper_options...");
-    ctranslate2::models::WhisperOptions whisper_options;
-
-    // Use proper beam search like Python faster-whisper
-    whisper_options.beam_size = options.beam_size;  // Use configured beam size (5)
-    whisper_options.patience = options.patience;    // Beam search patience for early stopping
-    whisper_options.num_hypotheses = 1;  // Single best hypothesis
-    if (temperature == 0.0f) {
-      // Greedy search - no sampling
-      whisper_options.sampling_topk = 1;  // Greedy
-      whisper_options.sampling_temperature = 1.0f;  // No effect in greedy
-    } else {
-      // Sampling with temperature
-      whisper_options.sampling_topk = 0;  // No top-k restriction
-      whisper_options.sampling_temperature = temperature;  // Use sampling temperature
-    }
-
-    whisper_options.length_penalty = options.length_penalty;
-    whisper_options.repetition_penalty = options.repetition_penalty;
-    whisper_options.no_repeat_ngram_size = options.no_repeat_ngram_size;
-    whisper_options.max_length = max_length;
-    whisper_options.suppress_blank = options.suppress_blank;
-    whisper_options.max_initial_timestamp_index = max_initial_timestamp_index;
-
-    if (options.suppress_tokens.has_value()) {
-      // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "Setting suppress_tokens...");
-      std::vector<int> suppress_tokens_int;
-      for (int token : options.suppress_tokens.value()) {
-        suppress_tokens_int.push_back(token);
-      }
-      whisper_options.suppress_tokens = suppress_tokens_int;
-      // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "suppress_tokens set with %zu tokens", suppress_tokens_int.size());
-    }
+    ctranslate2::models::WhisperOptions whisper_options = make_whisper_options(
+      options, temperature, max_length, max_initial_timestamp_index
+    );
 
     // __android_log_print(ANDROID_LOG_DEBUG, "#transcribe", "Converting prompt to size_t...");
     // Convert prompt to size_t for CTranslate2 (Python line 1432-1445)
@@ -1069,13 +1914,16 @@ WhisperModel::generate_with_fallback(
       decode_result = std::make_tuple(tokens, avg_logprob, temperature, compression_ratio);
       all_results.push_back(decode_result);
 
+      // Still generating when the budget ran out: a repetition loop that is certain to fail
+      bool runaway = length_capped && static_cast<int>(prompt.size()) + seq_len >= max_length - 1;
+
       bool needs_fallback = false;
 
       // Check compression ratio threshold (Python line 1467-1478)
       if (options.compression_ratio_threshold.has_value() &&
           compression_ratio > options.compression_ratio_threshold.value()) {
         needs_fallback = true;
-      } else {
+      } else if (!runaway) {
         below_cr_threshold_results.push_back(decode_result);
       }
 
@@ -1094,6 +1942,12 @@ WhisperModel::generate_with_fallback(
         needs_fallback = false; // silence
       }
 
+      if (runaway) {
+        std::cout << "#debug ⏭️  Attempt at temperature " << temperature << " hit the token budget ("
+                  << seq_len << " tokens), falling back" << std::endl;
+        needs_fallback = true;
+      }
+
       if (!needs_fallback) {
         break; // Success, return this result
       }
@@ -1132,6 +1986,130 @@ WhisperModel::generate_with_fallback(
   return decode_result;
 }
 
+std::vector<std::tuple<std::vector<int>, float, float, float>>
+WhisperModel::generate_with_fallback_batch(
+  const ctranslate2::StorageView &encoder_output,
+  const std::vector<std::vector<int>> &prompts,
+  Tokenizer &tokenizer,
+  const TranscriptionOptions &options,
+  std::optional<float> segment_duration
+) {
+  // Same fallback rules as generate_with_fallback, but every temperature is one
+  // batched generate() call over the inputs that still need a fallback
+  using DecodeResult = std::tuple<std::vector<int>, float, float, float>;
+  const size_t batch_size = prompts.size();
+  std::vector<std::vector<DecodeResult>> all_results(batch_size);
+  std::vector<std::vector<DecodeResult>> below_cr_threshold_results(batch_size);
+
+  int max_initial_timestamp_index = static_cast<int>(
+    std::round(options.max_initial_timestamp / time_precision)
+  );
+
+  size_t longest_prompt = 0;
+  for (const auto &prompt : prompts) {
+    longest_prompt = std::max(longest_prompt, prompt.size());
+  }
+  int max_length = options.max_new_tokens.has_value() ?
+                   static_cast<int>(longest_prompt) + options.max_new_tokens.value() :
+                   this->max_length;
+  if (max_length > this->max_length) {
+    throw std::runtime_error("Prompt + max_new_tokens exceeds Whisper max_length");
+  }
+
+  auto token_budget = window_token_budget(options, segment_duration);
+  bool length_capped = false;
+  if (token_budget.has_value() && static_cast<int>(longest_prompt) + *token_budget < max_length) {
+    max_length = static_cast<int>(longest_prompt) + *token_budget;
+    length_capped = true;
+  }
+
+  std::vector<size_t> pending(batch_size);
+  std::iota(pending.begin(), pending.end(), 0);
+
+  for (size_t temp_idx = 0; temp_idx < options.temperatures.size() && !pending.empty(); ++temp_idx) {
+    float temperature = options.temperatures[temp_idx];
+    auto whisper_options = make_whisper_options(options, temperature, max_length, max_initial_timestamp_index);
+
+    // Select the encoder states of the pending inputs (no copy on the first pass)
+    ctranslate2::StorageView pending_output;
+    const ctranslate2::StorageView *batch_output = &encoder_output;
+    if (pending.size() < batch_size) {
+      std::vector<int32_t> ids(pending.begin(), pending.end());
+      ctranslate2::StorageView indices({static_cast<ctranslate2::dim_t>(ids.size())}, ids);
+      ctranslate2::ops::Gather(0)(encoder_output, indices, pending_output);
+      batch_output = &pending_output;
+    }
+
+    std::vector<std::vector<size_t>> batch_prompts;
+    for (size_t b : pending) {
+      batch_prompts.emplace_back(prompts[b].begin(), prompts[b].end());
+    }
+
+    auto result_futures = model->generate(*batch_output, batch_prompts, whisper_options);
+
+    std::vector<size_t> still_pending;
+    for (size_t i = 0; i < pending.size(); ++i) {
+      size_t b = pending[i];
+      auto result = result_futures[i].get();
+
+      std::vector<int> tokens;
+      if (!result.sequences_ids.empty()) {
+        tokens.assign(result.sequences_ids[0].begin(), result.sequences_ids[0].end());
+      }
+      int seq_len = static_cast<int>(tokens.size());
+      float avg_logprob = 0.0f;
+      if (!result.scores.empty()) {
+        float cum_logprob = result.scores[0] * std::pow(seq_len, options.length_penalty);
+        avg_logprob = cum_logprob / (seq_len + 1);
+      }
+      float compression_ratio = get_compression_ratio(tokenizer.decode(tokens));
+
+      DecodeResult decode_result = std::make_tuple(tokens, avg_logprob, temperature, compression_ratio);
+      all_results[b].push_back(decode_result);
+
+      bool runaway = length_capped && static_cast<int>(prompts[b].size()) + seq_len >= max_length - 1;
+
+      bool needs_fallback = false;
+      if (options.compression_ratio_threshold.has_value() &&
+          compression_ratio > options.compression_ratio_threshold.value()) {
+        needs_fallback = true;
+      } else if (!runaway) {
+        below_cr_threshold_results[b].push_back(decode_result);
+      }
+      if (options.log_prob_threshold.has_value() &&
+          avg_logprob < options.log_prob_threshold.value()) {
+        needs_fallback = true;
+      }
+      if (options.no_speech_threshold.has_value() &&
+          result.no_speech_prob > options.no_speech_threshold.value() &&
+          options.log_prob_threshold.has_value() &&
+          avg_logprob < options.log_prob_threshold.value()) {
+        needs_fallback = false; // silence
+      }
+      if (runaway) {
+        needs_fallback = true;
+      }
+
+      if (needs_fallback) {
+        still_pending.push_back(b);
+      }
+    }
+    pending = still_pending;
+  }
+
+  // Pick the best attempt per input, like generate_with_fallback
+  auto by_logprob = [](const auto &a, const auto &b) { return std::get<1>(a) < std::get<1>(b); };
+  std::vector<DecodeResult> decode_results(batch_size);
+  for (size_t b = 0; b < batch_size; ++b) {
+    const auto &candidates = below_cr_threshold_results[b].empty() ? all_results[b] : below_cr_threshold_results[b];
+    if (!candidates.empty()) {
+      decode_results[b] = *std::max_element(candidates.begin(), candidates.end(), by_logprob);
+    }
+  }
+
+  return decode_results;
+}
+
 std::vector<int> WhisperModel::get_prompt(
   Tokenizer &tokenizer,
   const std::vector<int> &previous_tokens,
@@ -1304,6 +2282,18 @@ WhisperModel::find_alignment(
   const ctranslate2::StorageView &encoder_output,
   int num_frames,
   int median_filter_width
+) {
+  return find_alignment(tokenizer, text_tokens, encoder_output,
+                        std::vector<int>(text_tokens.size(), num_frames), median_filter_width);
+}
+
+std::vector<std::vector<std::map<std::string, std::any>>>
+WhisperModel::find_alignment(
+  Tokenizer &tokenizer,
+  const std::vector<std::vector<int>> &text_tokens,
+  const ctranslate2::StorageView &encoder_output,
+  const std::vector<int> &num_frames,
+  int median_filter_width
 ) {
   std::vector<std::vector<std::map<std::string, std::any>>> return_list;
   if (text_tokens.empty()) return return_list;
@@ -1319,8 +2309,8 @@ WhisperModel::find_alignment(
   text_tokens_size_t.push_back(converted_tokens);
   }
 
-  // Create num_frames vector - one entry per text sequence
-  std::vector<size_t> num_frames_vec(text_tokens_size_t.size(), static_cast<size_t>(num_frames));
+  // One entry per text sequence
+  std::vector<size_t> num_frames_vec(num_frames.begin(), num_frames.end());
 
   auto results_future = model->align(encoder_output, sot_sequence_size_t, text_tokens_size_t, num_frames_vec,
          static_cast<long>(median_filter_width));
@@ -1333,22 +2323,51 @@ WhisperModel::find_alignment(
 
   for (size_t i = 0; i < results.size(); ++i) {
   const auto &result = results[i];
-  const auto &tokens = text_tokens[i];
+  std::vector<int> tokens = text_tokens[i];
+  tokens.push_back(tokenizer.get_eot());
   auto [words, word_tokens] = tokenizer.split_to_word_tokens(tokens);
   if (word_tokens.size() <= 1) {
     return_list.push_back({});
     continue;
   }
 
-  // Construct alignment
+  // Token index where each word starts (Python: np.pad(np.cumsum(...), (1, 0)))
+  std::vector<size_t> word_boundaries = {0};
+  for (size_t j = 0; j + 1 < word_tokens.size(); ++j) {
+    word_boundaries.push_back(word_boundaries.back() + word_tokens[j].size());
+  }
+
+  // The DTW path moves to the next token at each jump; its time is where that token starts
+  std::vector<float> jump_times;
+  for (size_t k = 0; k < result.alignments.size(); ++k) {
+    if (k == 0 || result.alignments[k].first != result.alignments[k - 1].first) {
+    jump_times.push_back(static_cast<float>(result.alignments[k].second) / tokens_per_second);
+    }
+  }
+  if (jump_times.empty()) {
+    return_list.push_back({});
+    continue;
+  }
+  auto jump_time = [&](size_t index) {
+    return jump_times[std::min(index, jump_times.size() - 1)];
+  };
+
+  // The last word is <|endoftext|>, which only closes the word before it
   std::vector<std::map<std::string, std::any>> alignment_list;
-  for (size_t j = 0; j < words.size(); ++j) {
+  for (size_t j = 0; j + 1 < word_boundaries.size(); ++j) {
+    size_t first = word_boundaries[j];
+    size_t last = std::min(word_boundaries[j + 1], result.text_token_probs.size());
+    float probability = 0.0f;
+    if (last > first) {
+    probability = std::accumulate(result.text_token_probs.begin() + first,
+                    result.text_token_probs.begin() + last, 0.0f) / (last - first);
+    }
     alignment_list.push_back({
                {"word",        words[j]},
                {"tokens",      word_tokens[j]},
-               {"start",       0.0f},  // placeholder, compute from result
-               {"end",         0.0f},    // placeholder, compute from result
-               {"probability", 1.0f}  // placeholder
+               {"start",       jump_time(word_boundaries[j])},
+               {"end",         jump_time(word_boundaries[j + 1])},
+               {"probability", probability}
            });
   }
   return_list.push_back(alignment_list);
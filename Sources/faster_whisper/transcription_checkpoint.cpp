@@ -0,0 +1,180 @@
+//
+// transcription_checkpoint.cpp
+// SwiftFasterWhisper
+//
+// Created by Amr Aboelela on 10/18/2026.
+//
+
+#include "transcription_checkpoint.h"
+#include "byte_stream.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <zlib.h>
+
+namespace {
+
+constexpr char MAGIC[4] = {'F', 'W', 'C', 'P'};
+constexpr uint32_t VERSION = 3;  // 2: audio_crc, 3: no emitted segments
+
+void write_segment(ByteWriter& writer, const Segment& segment) {
+    writer.i32(segment.id);
+    writer.i32(segment.seek);
+    writer.f32(segment.start);
+    writer.f32(segment.end);
+    writer.string(segment.text);
+    writer.ints(segment.tokens);
+    writer.f32(segment.avg_logprob);
+    writer.f32(segment.compression_ratio);
+    writer.f32(segment.no_speech_prob);
+    writer.u8(segment.temperature.has_value() ? 1 : 0);
+    writer.f32(segment.temperature.value_or(0.0f));
+}
+
+Segment read_segment(ByteReader& reader) {
+    Segment segment;
+    segment.id = reader.i32();
+    segment.seek = reader.i32();
+    segment.start = reader.f32();
+    segment.end = reader.f32();
+    segment.text = reader.string();
+    segment.tokens = reader.ints();
+    segment.avg_logprob = reader.f32();
+    segment.compression_ratio = reader.f32();
+    segment.no_speech_prob = reader.f32();
+    bool has_temperature = reader.u8() != 0;
+    float temperature = reader.f32();
+    if (has_temperature) {
+        segment.temperature = temperature;
+    }
+    return segment;
+}
+
+// Reject positions a well-formed blob could still carry but the seek loop cannot resume from
+void check_positions(const TranscriptionCheckpoint& checkpoint) {
+    const auto& state = checkpoint.state;
+    if (state.seek < 0 || static_cast<uint64_t>(state.seek) > checkpoint.content_frames) {
+        throw std::runtime_error("Transcription checkpoint seek is outside the audio");
+    }
+    if (state.clip_idx > state.seek_clips.size()) {
+        throw std::runtime_error("Transcription checkpoint clip index is out of range");
+    }
+    // Clip ends may run past the audio (advance_seek_clip clamps them), starts may not go backwards
+    int previous_end = 0;
+    for (const auto& clip : state.seek_clips) {
+        if (clip.first < previous_end || clip.second < clip.first) {
+            throw std::runtime_error("Transcription checkpoint seek clips are not ordered");
+        }
+        previous_end = clip.second;
+    }
+    if (state.idx < 0) {
+        throw std::runtime_error("Transcription checkpoint segment id is negative");
+    }
+}
+
+} // namespace
+
+uint32_t TranscriptionCheckpoint::audio_digest(const std::vector<float>& audio) {
+    // zlib takes 32-bit lengths, so hours of audio are hashed in chunks
+    constexpr size_t CHUNK = size_t(1) << 30;
+    const auto* bytes = reinterpret_cast<const Bytef*>(audio.data());
+    size_t remaining = audio.size() * sizeof(float);
+    uLong crc = crc32(0L, Z_NULL, 0);
+    while (remaining > 0) {
+        const size_t length = std::min(remaining, CHUNK);
+        crc = crc32(crc, bytes, static_cast<uInt>(length));
+        bytes += length;
+        remaining -= length;
+    }
+    return static_cast<uint32_t>(crc);
+}
+
+std::vector<uint8_t> TranscriptionCheckpoint::serialize() const {
+    ByteWriter writer;
+    for (char c : MAGIC) {
+        writer.u8(static_cast<uint8_t>(c));
+    }
+    writer.u32(VERSION);
+
+    writer.string(language);
+    writer.f32(language_probability);
+    writer.string(task);
+    writer.u8(multilingual ? 1 : 0);
+    writer.f32(duration);
+    writer.u64(content_frames);
+    writer.u32(audio_crc);
+
+    writer.u32(static_cast<uint32_t>(state.seek_clips.size()));
+    for (const auto& clip : state.seek_clips) {
+        writer.i32(clip.first);
+        writer.i32(clip.second);
+    }
+    writer.u64(state.clip_idx);
+    writer.i32(state.seek);
+    writer.i32(state.idx);
+    writer.u8(state.finished ? 1 : 0);
+
+    // Only the tokens after the last prompt reset can reach a prompt, and get_prompt keeps at most
+    // MAX_PROMPT_TOKENS of those, so the rest of the history is dropped and the reset index rebased
+    size_t reset_since = std::min(static_cast<size_t>(state.prompt_reset_since), state.all_tokens.size());
+    size_t first = std::max(reset_since, state.all_tokens.size() - std::min(state.all_tokens.size(), MAX_PROMPT_TOKENS));
+    writer.ints(std::vector<int>(state.all_tokens.begin() + first, state.all_tokens.end()));
+
+    writer.u32(static_cast<uint32_t>(pending.size()));
+    for (const auto& segment : pending) {
+        write_segment(writer, segment);
+    }
+
+    auto& bytes = writer.bytes();
+    uint32_t crc = static_cast<uint32_t>(crc32(0L, bytes.data(), static_cast<uInt>(bytes.size())));
+    writer.u32(crc);
+    return std::move(bytes);
+}
+
+TranscriptionCheckpoint TranscriptionCheckpoint::deserialize(const uint8_t* data, size_t size) {
+    if (!data || size < sizeof(MAGIC) + 8 || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Not a transcription checkpoint");
+    }
+
+    ByteReader trailer(data + size - 4, 4, "Transcription checkpoint");
+    uint32_t expected_crc = trailer.u32();
+    if (static_cast<uint32_t>(crc32(0L, data, static_cast<uInt>(size - 4))) != expected_crc) {
+        throw std::runtime_error("Transcription checkpoint is corrupt (CRC mismatch)");
+    }
+
+    ByteReader reader(data + sizeof(MAGIC), size - sizeof(MAGIC) - 4, "Transcription checkpoint");
+    uint32_t version = reader.u32();
+    if (version != VERSION) {
+        throw std::runtime_error("Unsupported transcription checkpoint version " + std::to_string(version));
+    }
+
+    TranscriptionCheckpoint checkpoint;
+    checkpoint.language = reader.string();
+    checkpoint.language_probability = reader.f32();
+    checkpoint.task = reader.string();
+    checkpoint.multilingual = reader.u8() != 0;
+    checkpoint.duration = reader.f32();
+    checkpoint.content_frames = reader.u64();
+    checkpoint.audio_crc = reader.u32();
+
+    uint32_t clip_count = reader.u32();
+    for (uint32_t i = 0; i < clip_count; ++i) {
+        int start = reader.i32();
+        int end = reader.i32();
+        checkpoint.state.seek_clips.emplace_back(start, end);
+    }
+    checkpoint.state.clip_idx = reader.u64();
+    checkpoint.state.seek = reader.i32();
+    checkpoint.state.idx = reader.i32();
+    checkpoint.state.finished = reader.u8() != 0;
+    checkpoint.state.all_tokens = reader.ints();
+    checkpoint.state.prompt_reset_since = 0;
+    check_positions(checkpoint);
+
+    uint32_t pending_count = reader.u32();
+    for (uint32_t i = 0; i < pending_count; ++i) {
+        checkpoint.pending.push_back(read_segment(reader));
+    }
+
+    return checkpoint;
+}
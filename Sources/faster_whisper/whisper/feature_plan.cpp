@@ -0,0 +1,184 @@
+///
+/// feature_plan.cpp
+/// SwiftFasterWhisper
+///
+/// Created by Amr Aboelela on 10/18/2026.
+///
+
+#include "feature_plan.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace whisper {
+
+std::shared_ptr<const FeaturePlan> FeaturePlan::get(int sample_rate, int n_fft, int hop_length, int n_mels) {
+  static std::mutex mutex;
+  static std::map<std::tuple<int, int, int, int>, std::shared_ptr<const FeaturePlan>> plans;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto key = std::make_tuple(sample_rate, n_fft, hop_length, n_mels);
+  auto it = plans.find(key);
+  if (it == plans.end()) {
+    it = plans.emplace(key, std::shared_ptr<const FeaturePlan>(new FeaturePlan(sample_rate, n_fft, hop_length, n_mels))).first;
+  }
+  return it->second;
+}
+
+FeaturePlan::FeaturePlan(int sample_rate, int n_fft, int hop_length, int n_mels)
+  : sample_rate(sample_rate),
+    n_fft(n_fft),
+    hop_length(hop_length),
+    n_mels(n_mels)
+{
+  // Hann window: match Python's np.hanning(n_fft + 1)[:-1]
+  window.resize(n_fft);
+  for (int i = 0; i < n_fft; ++i) {
+    window[i] = 0.5f * (1.0f - std::cos(2.0f * M_PI * i / n_fft));
+  }
+
+  // Slaney-style mel filterbank (same construction as Python's faster-whisper)
+  const int n_bins = n_fft / 2 + 1;
+  std::vector<float> fftfreqs(n_bins);
+  for (int i = 0; i < n_bins; ++i) {
+    fftfreqs[i] = i * sample_rate / static_cast<float>(n_fft);
+  }
+
+  const float f_min = 0.0f;
+  const float f_sp = 200.0f / 3.0f;
+  const float min_log_hz = 1000.0f;                       // beginning of log region (Hz)
+  const float min_log_mel = (min_log_hz - f_min) / f_sp;  // same (Mels)
+  const float logstep = std::log(6.4f) / 27.0f;           // step size for log region
+
+  // Mel of the Nyquist frequency (the constant is Python's value for 16kHz)
+  const float nyquist = sample_rate / 2.0f;
+  const float max_mel = sample_rate == 16000 ? 45.245640471924965f :
+    (nyquist >= min_log_hz ? min_log_mel + std::log(nyquist / min_log_hz) / logstep : (nyquist - f_min) / f_sp);
+
+  std::vector<float> freqs(n_mels + 2);
+  for (int i = 0; i < n_mels + 2; ++i) {
+    float mel = max_mel * i / (n_mels + 1);
+    freqs[i] = mel >= min_log_mel ? min_log_hz * std::exp(logstep * (mel - min_log_mel)) : f_min + f_sp * mel;
+  }
+
+  mel_filters.assign(n_mels, std::vector<float>(n_bins, 0.0f));
+  mel_bands.resize(n_mels);
+  for (int mel = 0; mel < n_mels; ++mel) {
+    const float lower_diff = freqs[mel + 1] - freqs[mel];
+    const float upper_diff = freqs[mel + 2] - freqs[mel + 1];
+    const float enorm = 2.0f / (freqs[mel + 2] - freqs[mel]);
+    for (int j = 0; j < n_bins; ++j) {
+      float lower = -(freqs[mel] - fftfreqs[j]) / lower_diff;
+      float upper = (freqs[mel + 2] - fftfreqs[j]) / upper_diff;
+      mel_filters[mel][j] = std::max(0.0f, std::min(lower, upper)) * enorm;
+    }
+
+    // Each triangle is one contiguous run of bins
+    int first = 0;
+    while (first < n_bins && mel_filters[mel][first] == 0.0f) {
+      ++first;
+    }
+    int last = n_bins;
+    while (last > first && mel_filters[mel][last - 1] == 0.0f) {
+      --last;
+    }
+    mel_bands[mel].first_bin = first;
+    mel_bands[mel].weights.assign(mel_filters[mel].begin() + first, mel_filters[mel].begin() + last);
+  }
+
+  // FFT tables
+  const size_t n = static_cast<size_t>(n_fft);
+  const bool power_of_2 = n > 0 && (n & (n - 1)) == 0;
+  fft_size = 1;
+  while (fft_size < (power_of_2 ? n : 2 * n - 1)) {
+    fft_size *= 2;
+  }
+
+  twiddles.resize(fft_size / 2);
+  for (size_t k = 0; k < twiddles.size(); ++k) {
+    twiddles[k] = std::polar(1.0, -2.0 * M_PI * k / fft_size);
+  }
+
+  if (!power_of_2) {
+    chirp.resize(n);
+    for (size_t k = 0; k < n; ++k) {
+      double angle = -M_PI * k * k / n;
+      chirp[k] = std::complex<double>(std::cos(angle), std::sin(angle));
+    }
+
+    kernel_fft.assign(fft_size, 0.0);
+    kernel_fft[0] = std::conj(chirp[0]);
+    for (size_t k = 1; k < n; ++k) {
+      kernel_fft[k] = std::conj(chirp[k]);
+      kernel_fft[fft_size - k] = std::conj(chirp[k]);
+    }
+    fft(kernel_fft);
+  }
+}
+
+void FeaturePlan::fft(std::vector<std::complex<double>>& x) const {
+  const size_t n = fft_size;
+
+  // Bit-reversal permutation
+  for (size_t i = 1, j = 0; i < n; ++i) {
+    size_t bit = n >> 1;
+    for (; j & bit; bit >>= 1) {
+      j ^= bit;
+    }
+    j ^= bit;
+    if (i < j) {
+      std::swap(x[i], x[j]);
+    }
+  }
+
+  // Butterflies, reading twiddles at a stride of fft_size / len
+  for (size_t len = 2; len <= n; len <<= 1) {
+    const size_t half = len / 2;
+    const size_t stride = n / len;
+    for (size_t start = 0; start < n; start += len) {
+      for (size_t k = 0; k < half; ++k) {
+        std::complex<double> t = twiddles[k * stride] * x[start + k + half];
+        x[start + k + half] = x[start + k] - t;
+        x[start + k] += t;
+      }
+    }
+  }
+}
+
+void FeaturePlan::power_spectrum(const float* frame, float* power, std::vector<std::complex<double>>& scratch) const {
+  const size_t n = static_cast<size_t>(n_fft);
+  scratch.assign(fft_size, 0.0);
+
+  if (chirp.empty()) {
+    for (size_t k = 0; k < n; ++k) {
+      scratch[k] = frame[k];
+    }
+    fft(scratch);
+  } else {
+    // Bluestein: (x · chirp) ⊛ conj(chirp), then · chirp
+    for (size_t k = 0; k < n; ++k) {
+      scratch[k] = static_cast<double>(frame[k]) * chirp[k];
+    }
+    fft(scratch);
+    for (size_t i = 0; i < fft_size; ++i) {
+      scratch[i] = std::conj(scratch[i] * kernel_fft[i]);
+    }
+    fft(scratch);
+    for (size_t k = 0; k <= n / 2; ++k) {
+      scratch[k] = std::conj(scratch[k]) / static_cast<double>(fft_size) * chirp[k];
+    }
+  }
+
+  for (size_t k = 0; k <= n / 2; ++k) {
+    float magnitude = std::abs(std::complex<float>(static_cast<float>(scratch[k].real()), static_cast<float>(scratch[k].imag())));
+    power[k] = magnitude * magnitude;
+  }
+}
+
+} // namespace whisper
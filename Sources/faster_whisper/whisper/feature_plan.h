@@ -0,0 +1,68 @@
+///
+/// feature_plan.h
+/// SwiftFasterWhisper
+///
+/// Created by Amr Aboelela on 10/18/2026.
+///
+
+#ifndef FEATURE_PLAN_H
+#define FEATURE_PLAN_H
+
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace whisper {
+
+/**
+ * Immutable DSP tables for one feature configuration (Hann window, mel filterbank, FFT twiddles)
+ * Built once per (sample rate, n_fft, hop, n_mels) and shared by every extractor in the process,
+ * so extracting features does no per-call setup
+ */
+struct FeaturePlan {
+  /// Non-zero run of one mel filter
+  struct MelBand {
+    int first_bin;
+    std::vector<float> weights;
+  };
+
+  int sample_rate;
+  int n_fft;
+  int hop_length;
+  int n_mels;
+
+  std::vector<float> window;                    // np.hanning(n_fft + 1)[:-1]
+  std::vector<std::vector<float>> mel_filters;  // Dense Slaney filterbank [n_mels][n_fft / 2 + 1]
+  std::vector<MelBand> mel_bands;               // mel_filters without the zeros
+
+  // FFT of n_fft points: radix-2 when n_fft is a power of two, otherwise Bluestein's algorithm
+  // as a circular convolution of fft_size points with a precomputed kernel
+  size_t fft_size;
+  std::vector<std::complex<double>> twiddles;    // exp(-2πik / fft_size), k < fft_size / 2
+  std::vector<std::complex<double>> chirp;       // exp(-πik² / n_fft) (Bluestein only)
+  std::vector<std::complex<double>> kernel_fft;  // FFT of the conjugate chirp (Bluestein only)
+
+  /**
+   * Get the process-wide plan for a configuration, building it on first use (thread-safe)
+   */
+  static std::shared_ptr<const FeaturePlan> get(int sample_rate, int n_fft, int hop_length, int n_mels);
+
+  /**
+   * Power spectrum |rfft(frame)|² of one windowed frame
+   * @param frame n_fft samples
+   * @param power Output, n_fft / 2 + 1 bins
+   * @param scratch Reused work buffer (resized to fft_size)
+   */
+  void power_spectrum(const float* frame, float* power, std::vector<std::complex<double>>& scratch) const;
+
+private:
+  FeaturePlan(int sample_rate, int n_fft, int hop_length, int n_mels);
+
+  /// In-place radix-2 FFT of fft_size points using the twiddle table
+  void fft(std::vector<std::complex<double>>& x) const;
+};
+
+} // namespace whisper
+
+#endif // FEATURE_PLAN_H
@@ -0,0 +1,681 @@
+///
+/// flac_decoder.cpp
+/// SwiftFasterWhisper
+///
+/// Created by Amr Aboelela on 10/18/2026.
+///
+
+#include "flac_decoder.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+namespace whisper {
+
+namespace {
+
+// CRC-8 (poly 0x07) over frame headers and CRC-16 (poly 0x8005) over whole frames
+constexpr std::array<uint8_t, 256> make_crc8_table() {
+  std::array<uint8_t, 256> table{};
+  for (int i = 0; i < 256; ++i) {
+      uint8_t crc = static_cast<uint8_t>(i);
+      for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0x07) : static_cast<uint8_t>(crc << 1);
+      }
+      table[i] = crc;
+  }
+  return table;
+}
+
+constexpr std::array<uint16_t, 256> make_crc16_table() {
+  std::array<uint16_t, 256> table{};
+  for (int i = 0; i < 256; ++i) {
+      uint16_t crc = static_cast<uint16_t>(i << 8);
+      for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x8005) : static_cast<uint16_t>(crc << 1);
+      }
+      table[i] = crc;
+  }
+  return table;
+}
+
+constexpr std::array<uint8_t, 256> CRC8_TABLE = make_crc8_table();
+constexpr std::array<uint16_t, 256> CRC16_TABLE = make_crc16_table();
+
+uint8_t crc8(const uint8_t* data, size_t size) {
+  uint8_t crc = 0;
+  for (size_t i = 0; i < size; ++i) {
+      crc = CRC8_TABLE[crc ^ data[i]];
+  }
+  return crc;
+}
+
+uint16_t crc16(const uint8_t* data, size_t size) {
+  uint16_t crc = 0;
+  for (size_t i = 0; i < size; ++i) {
+      crc = static_cast<uint16_t>((crc << 8) ^ CRC16_TABLE[(crc >> 8) ^ data[i]]);
+  }
+  return crc;
+}
+
+/**
+ * MSB-first bit reader over one frame; throws if the frame is truncated
+ */
+class BitReader {
+public:
+  BitReader(const uint8_t* data, size_t size) : data_(data), size_(size), bit_pos_(0) {}
+
+  uint32_t read(unsigned bits) {
+      uint32_t value = 0;
+      while (bits > 0) {
+      size_t byte = bit_pos_ >> 3;
+      if (byte >= size_) {
+          throw std::runtime_error("FLAC frame truncated");
+      }
+      unsigned available = 8 - static_cast<unsigned>(bit_pos_ & 7);
+      unsigned take = std::min(available, bits);
+      uint32_t chunk = (data_[byte] >> (available - take)) & ((1u << take) - 1);
+      value = (value << take) | chunk;
+      bits -= take;
+      bit_pos_ += take;
+      }
+      return value;
+  }
+
+  int32_t read_signed(unsigned bits) {
+      if (bits == 0) {
+      return 0;
+      }
+      uint32_t value = read(bits);
+      if (bits < 32 && (value & (1u << (bits - 1)))) {
+      value |= ~0u << bits;  // Sign extend
+      }
+      return static_cast<int32_t>(value);
+  }
+
+  // Count zero bits up to (and consume) the next one bit
+  uint32_t read_unary() {
+      uint32_t count = 0;
+      while (true) {
+      size_t byte = bit_pos_ >> 3;
+      if (byte >= size_) {
+          throw std::runtime_error("FLAC frame truncated");
+      }
+      unsigned offset = static_cast<unsigned>(bit_pos_ & 7);
+      uint8_t rest = static_cast<uint8_t>(data_[byte] << offset);
+      if (rest == 0) {
+          count += 8 - offset;
+          bit_pos_ += 8 - offset;
+          continue;
+      }
+      unsigned zeros = 0;
+      while (!(rest & 0x80)) {
+          rest = static_cast<uint8_t>(rest << 1);
+          ++zeros;
+      }
+      count += zeros;
+      bit_pos_ += zeros + 1;
+      return count;
+      }
+  }
+
+  void align_to_byte() {
+      bit_pos_ = (bit_pos_ + 7) & ~static_cast<size_t>(7);
+  }
+
+  size_t byte_position() const {
+      return bit_pos_ >> 3;
+  }
+
+private:
+  const uint8_t* data_;
+  size_t size_;
+  size_t bit_pos_;
+};
+
+uint32_t read_be(const uint8_t* data, int bytes) {
+  uint32_t value = 0;
+  for (int i = 0; i < bytes; ++i) {
+      value = (value << 8) | data[i];
+  }
+  return value;
+}
+
+// STREAMINFO block body (34 bytes)
+void read_stream_info_block(const uint8_t* d, FlacDecoder::StreamInfo& info) {
+  info.min_block_size = read_be(d, 2);
+  info.max_block_size = read_be(d + 2, 2);
+  info.max_frame_size = read_be(d + 7, 3);
+  info.sample_rate = (static_cast<uint32_t>(d[10]) << 12) | (static_cast<uint32_t>(d[11]) << 4) | (d[12] >> 4);
+  info.num_channels = static_cast<uint16_t>(((d[12] >> 1) & 0x07) + 1);
+  info.bits_per_sample = static_cast<uint16_t>((((d[12] & 0x01) << 4) | (d[13] >> 4)) + 1);
+  info.total_samples = (static_cast<uint64_t>(d[13] & 0x0F) << 32) | read_be(d + 14, 4);
+}
+
+void decode_residual(BitReader& reader, uint32_t block_size, unsigned predictor_order, int32_t* residual) {
+  uint32_t method = reader.read(2);
+  if (method > 1) {
+      throw std::runtime_error("Reserved FLAC residual coding method");
+  }
+  const unsigned parameter_bits = method == 0 ? 4 : 5;
+  const uint32_t escape_code = method == 0 ? 0x0F : 0x1F;
+
+  const unsigned partition_order = reader.read(4);
+  const uint32_t partition_size = block_size >> partition_order;
+  if ((partition_size << partition_order) != block_size || partition_size < predictor_order) {
+      throw std::runtime_error("Invalid FLAC residual partition order");
+  }
+
+  size_t index = 0;
+  for (uint32_t partition = 0; partition < (1u << partition_order); ++partition) {
+      uint32_t count = partition_size - (partition == 0 ? predictor_order : 0);
+      uint32_t parameter = reader.read(parameter_bits);
+
+      if (parameter == escape_code) {
+      // Unencoded partition
+      unsigned bits = reader.read(5);
+      for (uint32_t i = 0; i < count; ++i) {
+          residual[index++] = reader.read_signed(bits);
+      }
+      } else {
+      // Rice coded: unary quotient, binary remainder, zigzag sign
+      for (uint32_t i = 0; i < count; ++i) {
+          uint32_t value = (reader.read_unary() << parameter) | reader.read(parameter);
+          residual[index++] = static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+      }
+      }
+  }
+}
+
+void decode_subframe(BitReader& reader, uint32_t block_size, unsigned bits_per_sample, int32_t* samples) {
+  if (reader.read(1) != 0) {
+      throw std::runtime_error("Invalid FLAC subframe padding");
+  }
+  const uint32_t type = reader.read(6);
+
+  unsigned wasted_bits = 0;
+  if (reader.read(1)) {
+      wasted_bits = reader.read_unary() + 1;
+      if (wasted_bits >= bits_per_sample) {
+      throw std::runtime_error("Invalid FLAC wasted bits");
+      }
+      bits_per_sample -= wasted_bits;
+  }
+
+  if (type == 0) {
+      // Constant
+      int32_t value = reader.read_signed(bits_per_sample);
+      std::fill(samples, samples + block_size, value);
+  } else if (type == 1) {
+      // Verbatim
+      for (uint32_t i = 0; i < block_size; ++i) {
+      samples[i] = reader.read_signed(bits_per_sample);
+      }
+  } else if ((type & 0x38) == 0x08) {
+      // Fixed predictor, order 0-4
+      unsigned order = type & 0x07;
+      if (order > 4 || order > block_size) {
+      throw std::runtime_error("Invalid FLAC fixed predictor order");
+      }
+      for (unsigned i = 0; i < order; ++i) {
+      samples[i] = reader.read_signed(bits_per_sample);
+      }
+      decode_residual(reader, block_size, order, samples + order);
+
+      for (uint32_t i = order; i < block_size; ++i) {
+      int64_t prediction = 0;
+      switch (order) {
+          case 1: prediction = samples[i - 1]; break;
+          case 2: prediction = 2 * int64_t(samples[i - 1]) - samples[i - 2]; break;
+          case 3: prediction = 3 * (int64_t(samples[i - 1]) - samples[i - 2]) + samples[i - 3]; break;
+          case 4: prediction = 4 * (int64_t(samples[i - 1]) + samples[i - 3]) - 6 * int64_t(samples[i - 2]) - samples[i - 4]; break;
+          default: break;
+      }
+      samples[i] = static_cast<int32_t>(samples[i] + prediction);
+      }
+  } else if (type & 0x20) {
+      // Linear predictor, order 1-32
+      unsigned order = (type & 0x1F) + 1;
+      if (order > block_size) {
+      throw std::runtime_error("Invalid FLAC LPC order");
+      }
+      for (unsigned i = 0; i < order; ++i) {
+      samples[i] = reader.read_signed(bits_per_sample);
+      }
+
+      unsigned precision = reader.read(4) + 1;
+      if (precision == 16) {
+      throw std::runtime_error("Invalid FLAC LPC precision");
+      }
+      int shift = reader.read_signed(5);
+      if (shift < 0) {
+      throw std::runtime_error("Negative FLAC LPC shift");
+      }
+      int32_t coefficients[32];
+      for (unsigned i = 0; i < order; ++i) {
+      coefficients[i] = reader.read_signed(precision);
+      }
+      decode_residual(reader, block_size, order, samples + order);
+
+      for (uint32_t i = order; i < block_size; ++i) {
+      int64_t sum = 0;
+      for (unsigned j = 0; j < order; ++j) {
+          sum += int64_t(coefficients[j]) * samples[i - 1 - j];
+      }
+      samples[i] = static_cast<int32_t>(samples[i] + (sum >> shift));
+      }
+  } else {
+      throw std::runtime_error("Reserved FLAC subframe type");
+  }
+
+  if (wasted_bits > 0) {
+      for (uint32_t i = 0; i < block_size; ++i) {
+      samples[i] = static_cast<int32_t>(static_cast<uint32_t>(samples[i]) << wasted_bits);
+      }
+  }
+}
+
+} // namespace
+
+FlacDecoder::FlacDecoder(const std::string& filename) : file_(filename, std::ios::binary) {
+  if (!file_.is_open() || !fill_buffer(4) || std::memcmp(buffer_.data(), "fLaC", 4) != 0) {
+      return;
+  }
+  buffer_pos_ = 4;
+
+  // Walk the metadata blocks, keeping only STREAMINFO
+  bool found_stream_info = false;
+  bool last = false;
+  while (!last) {
+      if (!fill_buffer(4)) {
+      return;
+      }
+      const uint8_t* block_header = buffer_.data() + buffer_pos_;
+      last = (block_header[0] & 0x80) != 0;
+      uint8_t type = block_header[0] & 0x7F;
+      uint32_t length = read_be(block_header + 1, 3);
+      buffer_pos_ += 4;
+
+      if (!fill_buffer(length)) {
+      return;
+      }
+      if (type == 0 && length >= 34) {
+      read_stream_info_block(buffer_.data() + buffer_pos_, info_);
+      found_stream_info = true;
+      }
+      buffer_pos_ += length;
+  }
+
+  open_ = found_stream_info && info_.bits_per_sample <= 24;
+  if (found_stream_info && !open_) {
+      std::cerr << "Unsupported FLAC bit depth: " << info_.bits_per_sample << std::endl;
+  }
+}
+
+bool FlacDecoder::is_open() const {
+  return open_;
+}
+
+const FlacDecoder::StreamInfo& FlacDecoder::info() const {
+  return info_;
+}
+
+bool FlacDecoder::next_frame(std::vector<float>& audio) {
+  if (!open_) {
+      return false;
+  }
+
+  // A frame is at most max_frame_size bytes when the encoder recorded it
+  size_t wanted = info_.max_frame_size > 0 ? info_.max_frame_size : (1 << 16);
+  const size_t limit = 1 << 24;
+
+  while (true) {
+      bool complete = fill_buffer(wanted);
+      size_t available = buffer_.size() - buffer_pos_;
+      if (available < 2) {
+      return false;  // End of stream
+      }
+
+      const uint8_t* frame = buffer_.data() + buffer_pos_;
+      FrameHeader header;
+      if (!parse_frame_header(frame, available, info_, header)) {
+      return false;
+      }
+
+      audio.resize(static_cast<size_t>(header.block_size) * header.num_channels);
+      size_t frame_size = decode_frame(frame, available, info_, audio.data(), header);
+      if (frame_size > 0) {
+      buffer_pos_ += frame_size;
+      return true;
+      }
+
+      // Frame did not fit in the buffer (or is corrupt): read more and retry
+      if (!complete || wanted >= limit) {
+      return false;
+      }
+      wanted *= 2;
+  }
+}
+
+bool FlacDecoder::fill_buffer(size_t bytes) {
+  size_t available = buffer_.size() - buffer_pos_;
+  if (available >= bytes) {
+      return true;
+  }
+
+  // Drop consumed bytes, then append from the file
+  buffer_.erase(buffer_.begin(), buffer_.begin() + static_cast<std::ptrdiff_t>(buffer_pos_));
+  buffer_pos_ = 0;
+
+  size_t old_size = buffer_.size();
+  buffer_.resize(bytes);
+  file_.read(reinterpret_cast<char*>(buffer_.data() + old_size), static_cast<std::streamsize>(bytes - old_size));
+  buffer_.resize(old_size + static_cast<size_t>(file_.gcount()));
+
+  return buffer_.size() >= bytes;
+}
+
+bool FlacDecoder::is_flac_file(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  char marker[4];
+  return file.read(marker, 4) && std::memcmp(marker, "fLaC", 4) == 0;
+}
+
+size_t FlacDecoder::parse_stream_info(const uint8_t* data, size_t size, StreamInfo& info) {
+  if (size < 4 || std::memcmp(data, "fLaC", 4) != 0) {
+      return 0;
+  }
+
+  size_t pos = 4;
+  bool found = false;
+  bool last = false;
+  while (!last) {
+      if (pos + 4 > size) {
+      return 0;
+      }
+      last = (data[pos] & 0x80) != 0;
+      uint8_t type = data[pos] & 0x7F;
+      uint32_t length = read_be(data + pos + 1, 3);
+      pos += 4;
+      if (pos + length > size) {
+      return 0;
+      }
+      if (type == 0 && length >= 34) {
+      read_stream_info_block(data + pos, info);
+      found = true;
+      }
+      pos += length;
+  }
+
+  return found ? pos : 0;
+}
+
+bool FlacDecoder::parse_frame_header(const uint8_t* data, size_t size, const StreamInfo& info, FrameHeader& header) {
+  // Sync code (14 bits) + reserved zero bit
+  if (size < 6 || data[0] != 0xFF || (data[1] & 0xFE) != 0xF8) {
+      return false;
+  }
+  header.variable_block_size = (data[1] & 0x01) != 0;
+
+  const uint8_t block_size_code = data[2] >> 4;
+  const uint8_t sample_rate_code = data[2] & 0x0F;
+  const uint8_t channel_code = data[3] >> 4;
+  const uint8_t sample_size_code = (data[3] >> 1) & 0x07;
+  if (block_size_code == 0 || sample_rate_code == 15 || channel_code > 10 ||
+      sample_size_code == 3 || sample_size_code == 7 || (data[3] & 0x01)) {
+      return false;
+  }
+
+  // Frame or sample number, UTF-8 style variable length
+  size_t pos = 4;
+  uint8_t lead = data[pos++];
+  uint64_t number = 0;
+  int extra = 0;
+  if (!(lead & 0x80)) {
+      number = lead;
+  } else {
+      int ones = 0;
+      while (ones < 8 && (lead & (0x80 >> ones))) {
+      ++ones;
+      }
+      if (ones < 2 || ones > 7) {
+      return false;
+      }
+      extra = ones - 1;
+      number = lead & ((1u << (7 - ones)) - 1);
+  }
+  if (pos + extra + 3 > size) {
+      return false;
+  }
+  for (int i = 0; i < extra; ++i) {
+      uint8_t byte = data[pos++];
+      if ((byte & 0xC0) != 0x80) {
+      return false;
+      }
+      number = (number << 6) | (byte & 0x3F);
+  }
+  header.number = number;
+
+  if (block_size_code == 1) {
+      header.block_size = 192;
+  } else if (block_size_code <= 5) {
+      header.block_size = 576u << (block_size_code - 2);
+  } else if (block_size_code == 6) {
+      header.block_size = data[pos++] + 1u;
+  } else if (block_size_code == 7) {
+      header.block_size = read_be(data + pos, 2) + 1u;
+      pos += 2;
+  } else {
+      header.block_size = 256u << (block_size_code - 8);
+  }
+
+  static const uint32_t sample_rates[] = {
+      0, 88200, 176400, 192000, 8000, 16000, 22050, 24000, 32000, 44100, 48000, 96000
+  };
+  if (pos + 3 > size) {
+      return false;
+  }
+  if (sample_rate_code == 0) {
+      header.sample_rate = info.sample_rate;
+  } else if (sample_rate_code < 12) {
+      header.sample_rate = sample_rates[sample_rate_code];
+  } else if (sample_rate_code == 12) {
+      header.sample_rate = data[pos++] * 1000u;
+  } else {
+      header.sample_rate = read_be(data + pos, 2) * (sample_rate_code == 14 ? 10u : 1u);
+      pos += 2;
+  }
+
+  header.channel_assignment = channel_code;
+  header.num_channels = static_cast<uint16_t>(channel_code < 8 ? channel_code + 1 : 2);
+
+  static const uint16_t sample_sizes[] = {0, 8, 12, 0, 16, 20, 24, 0};
+  header.bits_per_sample = sample_size_code == 0 ? info.bits_per_sample : sample_sizes[sample_size_code];
+  if (header.bits_per_sample == 0 || header.bits_per_sample > 24) {
+      return false;
+  }
+
+  if (pos >= size || crc8(data, pos) != data[pos]) {
+      return false;
+  }
+  header.header_size = pos + 1;
+  return true;
+}
+
+size_t FlacDecoder::decode_frame(const uint8_t* data, size_t size, const StreamInfo& info, float* output, FrameHeader& header) {
+  if (!parse_frame_header(data, size, info, header)) {
+      return 0;
+  }
+
+  const uint32_t block_size = header.block_size;
+  const uint16_t channels = header.num_channels;
+  thread_local std::vector<int32_t> samples;
+  samples.resize(static_cast<size_t>(block_size) * channels);
+
+  BitReader reader(data + header.header_size, size - header.header_size);
+  try {
+      for (uint16_t channel = 0; channel < channels; ++channel) {
+      // The side channel carries one extra bit
+      unsigned bits = header.bits_per_sample;
+      if ((header.channel_assignment == 8 && channel == 1) ||
+          (header.channel_assignment == 9 && channel == 0) ||
+          (header.channel_assignment == 10 && channel == 1)) {
+          bits += 1;
+      }
+      decode_subframe(reader, block_size, bits, samples.data() + static_cast<size_t>(channel) * block_size);
+      }
+  } catch (const std::exception&) {
+      return 0;
+  }
+  reader.align_to_byte();
+
+  size_t frame_size = header.header_size + reader.byte_position() + 2;
+  if (frame_size > size || crc16(data, frame_size - 2) != read_be(data + frame_size - 2, 2)) {
+      return 0;
+  }
+
+  // Undo inter-channel decorrelation
+  int32_t* first = samples.data();
+  int32_t* second = samples.data() + block_size;
+  if (header.channel_assignment == 8) {
+      for (uint32_t i = 0; i < block_size; ++i) {
+      second[i] = first[i] - second[i];  // right = left - side
+      }
+  } else if (header.channel_assignment == 9) {
+      for (uint32_t i = 0; i < block_size; ++i) {
+      first[i] = first[i] + second[i];   // left = side + right
+      }
+  } else if (header.channel_assignment == 10) {
+      for (uint32_t i = 0; i < block_size; ++i) {
+      int32_t side = second[i];
+      int32_t mid = static_cast<int32_t>((static_cast<uint32_t>(first[i]) << 1) | (side & 1));
+      first[i] = (mid + side) >> 1;
+      second[i] = (mid - side) >> 1;
+      }
+  }
+
+  // Interleave and scale to [-1, 1]
+  const float scale = 1.0f / static_cast<float>(1u << (header.bits_per_sample - 1));
+  for (uint16_t channel = 0; channel < channels; ++channel) {
+      const int32_t* src = samples.data() + static_cast<size_t>(channel) * block_size;
+      for (uint32_t i = 0; i < block_size; ++i) {
+      output[static_cast<size_t>(i) * channels + channel] = static_cast<float>(src[i]) * scale;
+      }
+  }
+
+  return frame_size;
+}
+
+bool FlacReader::read_flac_file(const std::string& filename, std::vector<float>& audio, WavReader::WavHeader& header, unsigned num_threads) {
+  std::ifstream file(filename, std::ios::binary | std::ios::ate);
+  if (!file.is_open()) {
+      return false;
+  }
+  std::vector<uint8_t> data(static_cast<size_t>(file.tellg()));
+  file.seekg(0);
+  if (!file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+      return false;
+  }
+
+  FlacDecoder::StreamInfo info;
+  size_t offset = FlacDecoder::parse_stream_info(data.data(), data.size(), info);
+  if (offset == 0) {
+      return false;
+  }
+  if (info.bits_per_sample > 24) {
+      std::cerr << "Unsupported FLAC bit depth: " << info.bits_per_sample << std::endl;
+      return false;
+  }
+
+  // Locate frames without decoding them: a sync code is accepted only if its header
+  // passes the CRC-8 and carries the next expected frame / sample number
+  struct FrameSpan {
+      size_t offset;
+      uint64_t first_sample;
+  };
+  std::vector<FrameSpan> frames;
+  uint64_t next_sample = 0;
+  uint64_t next_frame = 0;
+
+  while (offset + 2 <= data.size()) {
+      FlacDecoder::FrameHeader frame_header;
+      bool valid = FlacDecoder::parse_frame_header(data.data() + offset, data.size() - offset, info, frame_header) &&
+                   frame_header.num_channels == info.num_channels &&
+                   frame_header.number == (frame_header.variable_block_size ? next_sample : next_frame);
+      if (valid) {
+      frames.push_back({offset, next_sample});
+      next_sample += frame_header.block_size;
+      next_frame += 1;
+      offset += frame_header.header_size;
+      }
+
+      // Jump to the next candidate sync byte
+      const void* sync = std::memchr(data.data() + offset + (valid ? 0 : 1), 0xFF, data.size() - offset - (valid ? 0 : 1));
+      if (!sync) {
+      break;
+      }
+      offset = static_cast<const uint8_t*>(sync) - data.data();
+  }
+
+  if (frames.empty()) {
+      return false;
+  }
+
+  const size_t channels = info.num_channels;
+  audio.assign(static_cast<size_t>(next_sample) * channels, 0.0f);
+
+  // Frames are independent: split them into contiguous ranges, one per thread
+  if (num_threads == 0) {
+      num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  num_threads = static_cast<unsigned>(std::min<size_t>(num_threads, frames.size()));
+
+  std::atomic<bool> failed{false};
+  auto decode_range = [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end && !failed.load(std::memory_order_relaxed); ++i) {
+      size_t frame_end = (i + 1 < frames.size()) ? frames[i + 1].offset : data.size();
+      FlacDecoder::FrameHeader frame_header;
+      size_t decoded = FlacDecoder::decode_frame(
+          data.data() + frames[i].offset,
+          frame_end - frames[i].offset,
+          info,
+          audio.data() + frames[i].first_sample * channels,
+          frame_header
+      );
+      if (decoded == 0) {
+          failed = true;
+      }
+      }
+  };
+
+  std::vector<std::thread> workers;
+  size_t per_thread = (frames.size() + num_threads - 1) / num_threads;
+  for (unsigned t = 1; t < num_threads; ++t) {
+      size_t begin = t * per_thread;
+      size_t end = std::min(frames.size(), begin + per_thread);
+      if (begin < end) {
+      workers.emplace_back(decode_range, begin, end);
+      }
+  }
+  decode_range(0, std::min(frames.size(), per_thread));
+  for (auto& worker : workers) {
+      worker.join();
+  }
+
+  if (failed) {
+      std::cerr << "Corrupt FLAC frame in: " << filename << std::endl;
+      return false;
+  }
+
+  header.sample_rate = info.sample_rate;
+  header.num_channels = info.num_channels;
+  header.bits_per_sample = info.bits_per_sample;
+  header.data_size = static_cast<uint32_t>(audio.size() * ((info.bits_per_sample + 7) / 8));
+  return true;
+}
+
+} // namespace whisper
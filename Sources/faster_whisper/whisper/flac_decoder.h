@@ -0,0 +1,141 @@
+///
+/// flac_decoder.h
+/// SwiftFasterWhisper
+///
+/// Created by Amr Aboelela on 10/18/2026.
+///
+
+#ifndef FLAC_DECODER_H
+#define FLAC_DECODER_H
+
+#include "whisper_audio.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace whisper {
+
+/**
+ * Dependency-free FLAC decoder (native FLAC streams, up to 24 bits per sample)
+ *
+ * Frames can be decoded one at a time while reading the file (FlacDecoder::next_frame),
+ * or the whole file can be decoded at once with frames split across threads
+ * (FlacReader::read_flac_file).
+ */
+class FlacDecoder {
+public:
+  struct StreamInfo {
+      uint32_t min_block_size = 0;
+      uint32_t max_block_size = 0;
+      uint32_t max_frame_size = 0;
+      uint32_t sample_rate = 0;
+      uint16_t num_channels = 0;
+      uint16_t bits_per_sample = 0;
+      uint64_t total_samples = 0;    // Samples per channel (0 if unknown)
+  };
+
+  /**
+   * Header of one frame, parsed without decoding its subframes
+   */
+  struct FrameHeader {
+      uint32_t block_size = 0;       // Samples per channel in this frame
+      uint32_t sample_rate = 0;
+      uint16_t num_channels = 0;
+      uint16_t bits_per_sample = 0;
+      uint8_t channel_assignment = 0;
+      bool variable_block_size = false;
+      uint64_t number = 0;           // Frame number (fixed) or first sample number (variable)
+      size_t header_size = 0;        // Bytes, including the CRC-8
+  };
+
+  /**
+   * Open a FLAC file for frame-by-frame decoding
+   * @param filename Path to the .flac file
+   */
+  explicit FlacDecoder(const std::string& filename);
+
+  /**
+   * @return true if the file was opened and its STREAMINFO block parsed
+   */
+  bool is_open() const;
+
+  /**
+   * @return Stream parameters from the STREAMINFO block
+   */
+  const StreamInfo& info() const;
+
+  /**
+   * Decode the next frame (reads only as much of the file as needed)
+   * @param audio Output interleaved float samples in [-1, 1] (replaced, not appended)
+   * @return false at end of stream or on a corrupt frame
+   */
+  bool next_frame(std::vector<float>& audio);
+
+  /**
+   * Check for the "fLaC" stream marker
+   * @param filename Path to audio file
+   * @return true if the file is a native FLAC stream
+   */
+  static bool is_flac_file(const std::string& filename);
+
+  /**
+   * Parse the STREAMINFO block
+   * @param data File contents starting at the "fLaC" marker
+   * @param size Number of bytes available
+   * @param info Output stream parameters
+   * @return Offset of the first frame, or 0 if the stream is invalid
+   */
+  static size_t parse_stream_info(const uint8_t* data, size_t size, StreamInfo& info);
+
+  /**
+   * Parse and CRC-check a frame header
+   * @param data Bytes starting at a candidate sync code
+   * @param size Number of bytes available
+   * @param info Stream parameters (for values the header refers back to)
+   * @param header Output frame header
+   * @return true if this is a valid frame header
+   */
+  static bool parse_frame_header(const uint8_t* data, size_t size, const StreamInfo& info, FrameHeader& header);
+
+  /**
+   * Decode one frame
+   * @param data Bytes starting at the frame header
+   * @param size Number of bytes available
+   * @param info Stream parameters
+   * @param output Destination for interleaved float samples (block_size * num_channels values)
+   * @param header Output frame header
+   * @return Size of the frame in bytes, or 0 if the frame is corrupt
+   */
+  static size_t decode_frame(const uint8_t* data, size_t size, const StreamInfo& info, float* output, FrameHeader& header);
+
+private:
+  bool fill_buffer(size_t bytes);
+
+  std::ifstream file_;
+  StreamInfo info_;
+  std::vector<uint8_t> buffer_;      // Unread bytes of the file
+  size_t buffer_pos_ = 0;
+  bool open_ = false;
+};
+
+/**
+ * Whole-file FLAC reader with the same interface as WavReader
+ */
+class FlacReader {
+public:
+  /**
+   * Decode a FLAC file to interleaved float samples
+   * @param filename Path to the .flac file
+   * @param audio Output interleaved samples in [-1, 1]
+   * @param header Output format (data_size is the decoded PCM size in bytes)
+   * @param num_threads Decoding threads (0 = hardware concurrency)
+   * @return true on success
+   */
+  static bool read_flac_file(const std::string& filename, std::vector<float>& audio, WavReader::WavHeader& header, unsigned num_threads = 0);
+};
+
+} // namespace whisper
+
+#endif // FLAC_DECODER_H
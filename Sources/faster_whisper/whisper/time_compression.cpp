@@ -0,0 +1,120 @@
+///
+/// time_compression.cpp
+/// SwiftFasterWhisper
+///
+/// Created by Amr Aboelela on 10/18/2026.
+///
+
+#include "time_compression.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace whisper {
+
+namespace {
+
+constexpr float FRAME_SECONDS = 0.03f;      // Synthesis frame, 50% overlap
+constexpr float TOLERANCE_SECONDS = 0.008f; // Search range around the nominal position (covers an 80Hz pitch period)
+constexpr size_t CORRELATION_STRIDE = 2;    // Every other sample is enough to find the best alignment
+
+}
+
+float TimeMap::to_original(float seconds) const {
+  float original;
+  if (anchors.empty()) {
+    original = seconds * factor;
+  } else if (seconds <= anchors.front().first) {
+    original = anchors.front().second + (seconds - anchors.front().first) * factor;
+  } else if (seconds >= anchors.back().first) {
+    original = anchors.back().second + (seconds - anchors.back().first) * factor;
+  } else {
+    auto next = std::upper_bound(anchors.begin(), anchors.end(), seconds,
+      [](float value, const std::pair<float, float>& anchor) { return value < anchor.first; });
+    auto previous = next - 1;
+    float fraction = (seconds - previous->first) / (next->first - previous->first);
+    original = previous->second + fraction * (next->second - previous->second);
+  }
+  return std::min(std::max(original, 0.0f), original_duration);
+}
+
+std::vector<float> compress_time(const std::vector<float>& audio, float factor, TimeMap& map, int sample_rate) {
+  map = TimeMap();
+  map.original_duration = static_cast<float>(audio.size()) / sample_rate;
+  if (factor <= 1.0f || audio.empty()) {
+    map.compressed_duration = map.original_duration;
+    return audio;
+  }
+  map.factor = factor;
+
+  const size_t frame = std::max<size_t>(static_cast<size_t>(FRAME_SECONDS * sample_rate) & ~size_t(1), 2);
+  const size_t synthesis_hop = frame / 2;
+  const double analysis_hop = synthesis_hop * static_cast<double>(factor);
+  const size_t tolerance = static_cast<size_t>(TOLERANCE_SECONDS * sample_rate);
+  const size_t output_length = static_cast<size_t>(std::ceil(audio.size() / static_cast<double>(factor)));
+
+  // Periodic Hann window: overlapping frames at half a frame sum to one
+  std::vector<float> window(frame);
+  for (size_t i = 0; i < frame; ++i) {
+    window[i] = 0.5f * (1.0f - static_cast<float>(std::cos(2.0 * M_PI * i / frame)));
+  }
+
+  // Zero padding so frames near the end never read past the input
+  std::vector<float> input(audio);
+  input.resize(audio.size() + 3 * frame + 2 * tolerance, 0.0f);
+
+  std::vector<float> output(output_length + frame, 0.0f);
+  std::vector<float> weight(output_length + frame, 0.0f);
+
+  size_t previous = 0;
+  for (size_t k = 0; k * synthesis_hop < output_length; ++k) {
+    const size_t nominal = static_cast<size_t>(std::llround(k * analysis_hop));
+    size_t position = nominal;
+
+    if (k > 0) {
+      // The frame that would naturally follow the previous one; pick the candidate that resembles it most
+      const float* natural = input.data() + previous + synthesis_hop;
+      const size_t first = nominal > tolerance ? nominal - tolerance : 0;
+      const size_t last = nominal + tolerance;
+      float best = -std::numeric_limits<float>::infinity();
+      for (size_t candidate = first; candidate <= last; ++candidate) {
+        const float* x = input.data() + candidate;
+        float correlation = 0.0f;
+        for (size_t i = 0; i < frame; i += CORRELATION_STRIDE) {
+          correlation += natural[i] * x[i];
+        }
+        // Ties (e.g. silence) keep the candidate closest to the nominal position
+        if (correlation > best || (correlation == best &&
+            (candidate > nominal ? candidate - nominal : nominal - candidate) <
+            (position > nominal ? position - nominal : nominal - position))) {
+          best = correlation;
+          position = candidate;
+        }
+      }
+    }
+
+    const size_t start = k * synthesis_hop;
+    for (size_t i = 0; i < frame; ++i) {
+      output[start + i] += window[i] * input[position + i];
+      weight[start + i] += window[i];
+    }
+    map.anchors.emplace_back(static_cast<float>(start) / sample_rate, static_cast<float>(position) / sample_rate);
+    previous = position;
+  }
+
+  output.resize(output_length);
+  for (size_t i = 0; i < output_length; ++i) {
+    if (weight[i] > 1e-3f) {
+      output[i] /= weight[i];
+    }
+  }
+
+  map.compressed_duration = static_cast<float>(output_length) / sample_rate;
+  return output;
+}
+
+} // namespace whisper
@@ -0,0 +1,47 @@
+///
+/// time_compression.h
+/// SwiftFasterWhisper
+///
+/// Created by Amr Aboelela on 10/18/2026.
+///
+
+#ifndef TIME_COMPRESSION_H
+#define TIME_COMPRESSION_H
+
+#include <utility>
+#include <vector>
+
+namespace whisper {
+
+/**
+ * Correspondence between compressed and original time of a compress_time call
+ */
+struct TimeMap {
+  float factor = 1.0f;
+  float original_duration = 0.0f;    // Seconds
+  float compressed_duration = 0.0f;  // Seconds
+  std::vector<std::pair<float, float>> anchors;  // (compressed, original) seconds at the start of each synthesis frame
+
+  /**
+   * Map a time in the compressed audio back to the original audio
+   * @param seconds Time in the compressed audio
+   * @return Time in the original audio, within [0, original_duration]
+   */
+  float to_original(float seconds) const;
+};
+
+/**
+ * Speed speech up by a factor without changing its pitch (WSOLA)
+ * Each 30ms synthesis frame is taken from near its nominal position in the input, shifted by up to 8ms
+ * to the offset that best continues the previous frame, so pitch periods line up in the overlap-add
+ * @param audio Input samples
+ * @param factor Speed-up, e.g. 1.25 plays 30 seconds of audio in 24 (values <= 1 return the audio unchanged)
+ * @param map Output, maps timestamps in the result back to the input
+ * @param sample_rate Sample rate of audio
+ * @return About audio.size() / factor samples
+ */
+std::vector<float> compress_time(const std::vector<float>& audio, float factor, TimeMap& map, int sample_rate = 16000);
+
+} // namespace whisper
+
+#endif // TIME_COMPRESSION_H
@@ -6,7 +6,7 @@
 ///
 
 #include "whisper_audio.h"
-#include "fft.h"
+#include "flac_decoder.h"
 #include <fstream>
 #include <algorithm>
 #include <cstring>
@@ -18,6 +18,12 @@
 #include <ctime>
 #include <sstream>
 
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#elif defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
@@ -46,18 +52,26 @@ void logAudioTimestamp(const std::string& message) {
 
 namespace whisper {
 
+// Read WAV or FLAC (detected from the stream marker) into interleaved float samples
+static bool read_audio_file(const std::string& filename, std::vector<float>& audio, WavReader::WavHeader& header) {
+  if (FlacDecoder::is_flac_file(filename)) {
+      return FlacReader::read_flac_file(filename, audio, header);
+  }
+  return WavReader::read_wav_file(filename, audio, header);
+}
+
 std::vector<float> AudioProcessor::decode_audio(const std::string& input_file, int sampling_rate, bool split_stereo) {
   WavReader::WavHeader header;
   std::vector<float> audio;
 
-  if (!WavReader::read_wav_file(input_file, audio, header)) {
+  if (!read_audio_file(input_file, audio, header)) {
       std::cerr << "Failed to load audio file: " << input_file << std::endl;
       return {};
   }
 
-  // Convert to mono if stereo (unless split_stereo is requested)
-  if (header.num_channels == 2 && !split_stereo) {
-      audio = stereo_to_mono(audio);
+  // Convert to mono if multichannel (unless split_stereo is requested for a stereo file)
+  if (header.num_channels > 1 && !(split_stereo && header.num_channels == 2)) {
+      audio = downmix(audio, header.num_channels);
   }
 
   // Resample if needed
@@ -72,14 +86,14 @@ std::vector<float> AudioProcessor::load_audio(const std::string& filename) {
   WavReader::WavHeader header;
   std::vector<float> audio;
 
-  if (!WavReader::read_wav_file(filename, audio, header)) {
+  if (!read_audio_file(filename, audio, header)) {
       std::cerr << "Failed to load audio file: " << filename << std::endl;
       return {};
   }
 
-  // Convert to mono if stereo
-  if (header.num_channels == 2) {
-      audio = stereo_to_mono(audio);
+  // Convert to mono if stereo or multichannel
+  if (header.num_channels > 1) {
+      audio = downmix(audio, header.num_channels);
   }
 
   // Resample to 16kHz if needed
@@ -93,6 +107,35 @@ std::vector<float> AudioProcessor::load_audio(const std::string& filename) {
   return audio;
 }
 
+std::pair<std::vector<float>, std::vector<float>> AudioProcessor::load_audio_split_stereo(const std::string& filename) {
+  WavReader::WavHeader header;
+  std::vector<float> audio;
+
+  if (!read_audio_file(filename, audio, header)) {
+      std::cerr << "Failed to load audio file: " << filename << std::endl;
+      return {};
+  }
+
+  if (header.num_channels != 2) {
+      // Mono stays as is; more than two channels have no left / right speaker, so they are mixed down
+      audio = downmix(audio, header.num_channels);
+      if (header.sample_rate != WHISPER_SAMPLE_RATE) {
+      audio = resample_audio(audio, header.sample_rate);
+      }
+      return {audio, {}};
+  }
+
+  auto channels = split_stereo(audio);
+
+  // Resample each channel separately (resampling interleaved data would mix them)
+  if (header.sample_rate != WHISPER_SAMPLE_RATE) {
+      channels.first = resample_audio(channels.first, header.sample_rate);
+      channels.second = resample_audio(channels.second, header.sample_rate);
+  }
+
+  return channels;
+}
+
 std::vector<float> AudioProcessor::resample_audio(const std::vector<float>& audio, int input_sample_rate) {
   if (input_sample_rate == WHISPER_SAMPLE_RATE) {
       return audio;
@@ -129,6 +172,62 @@ std::vector<float> AudioProcessor::stereo_to_mono(const std::vector<float>& ster
   return mono_audio;
 }
 
+std::vector<float> AudioProcessor::downmix(const std::vector<float>& audio, int num_channels) {
+  if (num_channels <= 1) {
+      return audio;
+  }
+  if (num_channels == 2) {
+      return stereo_to_mono(audio);
+  }
+
+  const size_t channels = static_cast<size_t>(num_channels);
+  const float scale = 1.0f / static_cast<float>(num_channels);
+  std::vector<float> mono_audio(audio.size() / channels);
+  for (size_t frame = 0; frame < mono_audio.size(); ++frame) {
+      const float* src = audio.data() + frame * channels;
+      float sum = 0.0f;
+      for (size_t channel = 0; channel < channels; ++channel) {
+          sum += src[channel];
+      }
+      mono_audio[frame] = sum * scale;
+  }
+
+  return mono_audio;
+}
+
+std::pair<std::vector<float>, std::vector<float>> AudioProcessor::split_stereo(const std::vector<float>& stereo_audio) {
+  const size_t frames = stereo_audio.size() / 2;
+  std::vector<float> left(frames);
+  std::vector<float> right(frames);
+
+  const float* src = stereo_audio.data();
+  size_t i = 0;
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+  // vld2q deinterleaves 4 frames (8 samples) per load
+  for (; i + 4 <= frames; i += 4) {
+      float32x4x2_t lr = vld2q_f32(src + 2 * i);
+      vst1q_f32(left.data() + i, lr.val[0]);
+      vst1q_f32(right.data() + i, lr.val[1]);
+  }
+#elif defined(__SSE__)
+  // Two loads of [L R L R], then pick even / odd lanes
+  for (; i + 4 <= frames; i += 4) {
+      __m128 a = _mm_loadu_ps(src + 2 * i);
+      __m128 b = _mm_loadu_ps(src + 2 * i + 4);
+      _mm_storeu_ps(left.data() + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+      _mm_storeu_ps(right.data() + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+  }
+#endif
+
+  for (; i < frames; ++i) {
+      left[i] = src[2 * i];
+      right[i] = src[2 * i + 1];
+  }
+
+  return {std::move(left), std::move(right)};
+}
+
 std::vector<float> AudioProcessor::normalize_audio(const std::vector<float>& audio) {
   if (audio.empty()) return audio;
 
@@ -167,8 +266,12 @@ std::vector<float> AudioProcessor::apply_preemphasis(const std::vector<float>& a
 }
 
 std::vector<std::vector<float>> AudioProcessor::extract_mel_spectrogram(const std::vector<float>& audio) {
+  return extract_mel_spectrogram(audio, default_plan());
+}
+
+std::vector<std::vector<float>> AudioProcessor::extract_mel_spectrogram(const std::vector<float>& audio, const FeaturePlan& plan) {
   // Compute STFT directly (no pre-emphasis to match Python's faster-whisper)
-  auto stft = compute_stft(audio);
+  auto stft = compute_stft(audio, plan);
 
 //  logAudioTimestamp("STFT output shape (complex)");
 //  std::cout << "  STFT output shape (complex): (" << stft.size() << ", " << (stft.empty() ? 0 : stft[0].size()) << ")" << std::endl;
@@ -225,42 +328,21 @@ std::vector<std::vector<float>> AudioProcessor::extract_mel_spectrogram(const st
 //   std::cout << std::fixed; // Reset to fixed notation
 
   // Apply mel filter bank
-  auto mel_filters = get_mel_filter_bank();
-
-  // Debug: Log mel filter stats
-  float mel_filter_min = std::numeric_limits<float>::infinity();
-  float mel_filter_max = -std::numeric_limits<float>::infinity();
-  double mel_filter_sum = 0.0;
-  size_t mel_filter_count = 0;
-  for (const auto& mel_filter_band : mel_filters) {
-    for (float val : mel_filter_band) {
-      mel_filter_min = std::min(mel_filter_min, val);
-      mel_filter_max = std::max(mel_filter_max, val);
-      mel_filter_sum += val;
-      mel_filter_count++;
-    }
-  }
-  float mel_filter_mean = mel_filter_sum / mel_filter_count;
-  (void)mel_filter_min;  // Unused but calculated for debugging
-  (void)mel_filter_max;
-  (void)mel_filter_mean;
-  //   std::cout << "  Mel filter stats: min=" << std::setprecision(6) << mel_filter_min << ", max=" << mel_filter_max << ", mean=" << mel_filter_mean << std::endl;
-
-  // Apply mel filters to STFT magnitude
   // STFT is now [freq_bins][time_frames], mel_spec should be [mel_bins][time_frames]
-  std::vector<std::vector<float>> mel_spec(WHISPER_N_MEL);
+  // Only the non-zero run of each filter is visited, one frequency row at a time
+  std::vector<std::vector<float>> mel_spec(plan.n_mels);
   size_t num_time_frames = stft.empty() ? 0 : stft[0].size();
 
-  for (int mel = 0; mel < WHISPER_N_MEL; ++mel) {
-      mel_spec[mel].resize(num_time_frames);
+  for (int mel = 0; mel < plan.n_mels; ++mel) {
+    mel_spec[mel].assign(num_time_frames, 0.0f);
+    const auto& band = plan.mel_bands[mel];
+    for (size_t i = 0; i < band.weights.size() && band.first_bin + i < stft.size(); ++i) {
+      const float weight = band.weights[i];
+      const auto& freq_row = stft[band.first_bin + i];
       for (size_t frame = 0; frame < num_time_frames; ++frame) {
-      float mel_value = 0.0f;
-      // Sum over frequency bins: mel_value = sum(mel_filter[freq] * stft[freq][frame])
-      for (size_t freq = 0; freq < stft.size() && freq < mel_filters[mel].size(); ++freq) {
-          mel_value += mel_filters[mel][freq] * stft[freq][frame];
-      }
-      mel_spec[mel][frame] = mel_value;
+        mel_spec[mel][frame] += weight * freq_row[frame];
       }
+    }
   }
 
   // Log raw mel spec shape first
@@ -328,11 +410,10 @@ std::vector<std::vector<float>> AudioProcessor::apply_log_transform(const std::v
   return log_mel_spec;
 }
 
-std::vector<std::vector<float>> AudioProcessor::compute_stft(const std::vector<float>& audio) {
-  const int window_size = WHISPER_N_FFT;
-  const int hop_size = WHISPER_HOP_LENGTH;
-
-  auto window = apply_hann_window(window_size);
+std::vector<std::vector<float>> AudioProcessor::compute_stft(const std::vector<float>& audio, const FeaturePlan& plan) {
+  const int window_size = plan.n_fft;
+  const int hop_size = plan.hop_length;
+  const auto& window = plan.window;
 
   // Apply center padding (matches Python's center=True in STFT)
   const int pad_amount = window_size / 2;
@@ -348,6 +429,8 @@ std::vector<std::vector<float>> AudioProcessor::compute_stft(const std::vector<f
 
   // Pre-calculate frequency bins size
   const int n_freq_bins = window_size / 2 + 1;
+  std::vector<float> power(n_freq_bins);
+  std::vector<std::complex<double>> scratch;
 
   // Allocate result in final transposed format: [freq_bins, time_frames]
   std::vector<std::vector<float>> stft_magnitude(n_freq_bins, std::vector<float>(num_frames));
@@ -364,47 +447,12 @@ std::vector<std::vector<float>> AudioProcessor::compute_stft(const std::vector<f
           frame_data[n] = 0.0f;
       }
 
-      // Compute FFT using proper FFT implementation
-      auto fft_result = FFT::rfft(frame_data);
-
-      // Debug: log first FFT result for first non-zero frame
-      //static bool logged_fft = false;
-      //if (!logged_fft && frame == 100) {  // Check frame 100 to avoid all-zero frames
-      //  logAudioTimestamp("DEBUG FFT frame 100: First 5 complex values");
-      //  std::cout << "  DEBUG FFT frame 100: First 5 complex values: [";
-      //  for (size_t i = 0; i < std::min(size_t(5), fft_result.size()); ++i) {
-      //    // Add proper spacing between complex numbers
-      //    if (i > 0) std::cout << " ";
-      //    // Add line break after 3rd value to match Python's display
-      //    if (i == 3) std::cout << "\n ";
-      //
-      //    // Format complex numbers to match Python's output
-      //    float real_part = fft_result[i].real();
-      //    float imag_part = fft_result[i].imag();
-      //
-      //    // Format real part with appropriate width and precision
-      //    std::cout << std::setw(12) << std::fixed << std::setprecision(8) << real_part;
-      //
-      //    // Format imaginary part
-      //    if (std::abs(imag_part) < 1e-9f) {
-      //      // For zero imaginary part, use "0.j" format like Python
-      //      std::cout << "+0.j";
-      //    } else {
-      //      // For non-zero imaginary part, add sign and value
-      //      if (imag_part >= 0) {
-      //        std::cout << "+";
-      //      }
-      //      std::cout << std::setprecision(8) << imag_part << "j";
-      //    }
-      //  }
-      //  std::cout << "]" << std::endl;
-      //  logged_fft = true;
-      //}
-
-      // Compute magnitude squared and store directly in transposed format
-      for (size_t i = 0; i < fft_result.size(); ++i) {
-          float mag = std::abs(fft_result[i]);
-          stft_magnitude[i][frame] = mag * mag;  // Square the magnitude, store in [freq][frame]
+      // Magnitude squared from the plan's precomputed FFT tables
+      plan.power_spectrum(frame_data.data(), power.data(), scratch);
+
+      // Store directly in transposed format
+      for (int i = 0; i < n_freq_bins; ++i) {
+          stft_magnitude[i][frame] = power[i];  // [freq][frame]
       }
   }
 
@@ -424,86 +472,11 @@ std::vector<float> AudioProcessor::apply_hann_window(int window_size) {
   return window;
 }
 
-std::vector<std::vector<float>> AudioProcessor::get_mel_filter_bank() {
-  std::vector<std::vector<float>> mel_filters(WHISPER_N_MEL);
-
-  // Match Python's Slaney-style mel scale (not HTK mel scale)
-  // Python uses a piecewise linear/logarithmic scale
-  const int n_fft = WHISPER_N_FFT;
-  const int sr = WHISPER_SAMPLE_RATE;
-
-  // Center freqs of each FFT bin
-  std::vector<float> fftfreqs(n_fft / 2 + 1);
-  for (int i = 0; i <= n_fft / 2; ++i) {
-    fftfreqs[i] = i * sr / static_cast<float>(n_fft);
-  }
-
-  // Mel scale parameters (from Python's faster-whisper)
-  const float min_mel = 0.0f;
-  const float max_mel = 45.245640471924965f;
-
-  // Create equally spaced mel points
-  std::vector<float> mels(WHISPER_N_MEL + 2);
-  for (int i = 0; i < WHISPER_N_MEL + 2; ++i) {
-    mels[i] = min_mel + (max_mel - min_mel) * i / (WHISPER_N_MEL + 1);
-  }
-
-  // Fill in the linear scale
-  const float f_min = 0.0f;
-  const float f_sp = 200.0f / 3.0f;
-  std::vector<float> freqs(mels.size());
-  for (size_t i = 0; i < mels.size(); ++i) {
-    freqs[i] = f_min + f_sp * mels[i];
-  }
-
-  // And now the nonlinear scale
-  const float min_log_hz = 1000.0f;  // beginning of log region (Hz)
-  const float min_log_mel = (min_log_hz - f_min) / f_sp;  // same (Mels)
-  const float logstep = std::log(6.4f) / 27.0f;  // step size for log region
-
-  for (size_t i = 0; i < mels.size(); ++i) {
-    if (mels[i] >= min_log_mel) {
-      freqs[i] = min_log_hz * std::exp(logstep * (mels[i] - min_log_mel));
-    }
-  }
-
-  // Compute fdiff
-  std::vector<float> fdiff(freqs.size() - 1);
-  for (size_t i = 0; i < fdiff.size(); ++i) {
-    fdiff[i] = freqs[i + 1] - freqs[i];
-  }
-
-  // Create ramps matrix: freqs.reshape(-1, 1) - fftfreqs.reshape(1, -1)
-  // ramps[i][j] = freqs[i] - fftfreqs[j]
-  std::vector<std::vector<float>> ramps(freqs.size(), std::vector<float>(fftfreqs.size()));
-  for (size_t i = 0; i < freqs.size(); ++i) {
-    for (size_t j = 0; j < fftfreqs.size(); ++j) {
-      ramps[i][j] = freqs[i] - fftfreqs[j];
-    }
-  }
-
-  // Create mel filters
-  for (int mel = 0; mel < WHISPER_N_MEL; ++mel) {
-    mel_filters[mel].resize(fftfreqs.size(), 0.0f);
-
-    // lower = -ramps[mel] / fdiff[mel]
-    // upper = ramps[mel+2] / fdiff[mel+1]
-    // weights = max(0, min(lower, upper))
-
-    for (size_t j = 0; j < fftfreqs.size(); ++j) {
-      float lower = -ramps[mel][j] / fdiff[mel];
-      float upper = ramps[mel + 2][j] / fdiff[mel + 1];
-      mel_filters[mel][j] = std::max(0.0f, std::min(lower, upper));
-    }
-
-    // Apply Slaney-style normalization
-    float enorm = 2.0f / (freqs[mel + 2] - freqs[mel]);
-    for (size_t j = 0; j < mel_filters[mel].size(); ++j) {
-      mel_filters[mel][j] *= enorm;
-    }
-  }
-
-  return mel_filters;
+const FeaturePlan& AudioProcessor::default_plan() {
+  // Whisper's fixed configuration, built once and kept for the life of the process
+  static const std::shared_ptr<const FeaturePlan> plan =
+    FeaturePlan::get(WHISPER_SAMPLE_RATE, WHISPER_N_FFT, WHISPER_HOP_LENGTH, WHISPER_N_MEL);
+  return *plan;
 }
 
 float AudioProcessor::hz_to_mel(float hz) {
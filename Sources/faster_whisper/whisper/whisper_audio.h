@@ -12,6 +12,8 @@
 #include <string>
 #include <cstdint>
 #include <cmath>
+#include <utility>
+#include "feature_plan.h"
 
 // Constants matching whisper.cpp expectations
 constexpr int WHISPER_SAMPLE_RATE = 16000;
@@ -38,11 +40,18 @@ public:
 
   /**
    * Load audio from file and convert to whisper-compatible format
-   * @param filename Path to audio file
+   * @param filename Path to audio file (16-bit PCM WAV or FLAC)
    * @return Vector of float samples at 16kHz mono
    */
   static std::vector<float> load_audio(const std::string& filename);
 
+  /**
+   * Load a stereo file keeping the channels separate (e.g. agent / customer call recordings)
+   * @param filename Path to audio file
+   * @return Left and right channels at 16kHz (right is empty for mono files)
+   */
+  static std::pair<std::vector<float>, std::vector<float>> load_audio_split_stereo(const std::string& filename);
+
   /**
    * Resample audio to 16kHz if needed
    * @param audio Input audio samples
@@ -58,6 +67,21 @@ public:
    */
   static std::vector<float> stereo_to_mono(const std::vector<float>& stereo_audio);
 
+  /**
+   * Convert any number of channels to mono by averaging them
+   * @param audio Interleaved samples
+   * @param num_channels Channels per frame (audio is returned as is for 0 or 1)
+   * @return Mono audio samples
+   */
+  static std::vector<float> downmix(const std::vector<float>& audio, int num_channels);
+
+  /**
+   * Deinterleave stereo into separate channels (NEON / SSE with scalar tail)
+   * @param stereo_audio Interleaved stereo samples
+   * @return Left and right channel samples
+   */
+  static std::pair<std::vector<float>, std::vector<float>> split_stereo(const std::vector<float>& stereo_audio);
+
   /**
    * Normalize audio to [-1, 1] range
    * @param audio Input audio
@@ -80,6 +104,14 @@ public:
    */
   static std::vector<std::vector<float>> extract_mel_spectrogram(const std::vector<float>& audio);
 
+  /**
+   * Extract mel spectrogram features using a shared feature plan
+   * @param audio Input audio samples at the plan's sample rate
+   * @param plan Window, filterbank and FFT tables (see FeaturePlan::get)
+   * @return Mel spectrogram matrix [n_mels, n_frames]
+   */
+  static std::vector<std::vector<float>> extract_mel_spectrogram(const std::vector<float>& audio, const FeaturePlan& plan);
+
   /**
    * Apply log mel spectrogram transformation
    * @param mel_spectrogram Input mel spectrogram
@@ -96,8 +128,8 @@ public:
 
 private:
   // FFT and STFT utilities
-  static std::vector<std::vector<float>> compute_stft(const std::vector<float>& audio);
-  static std::vector<std::vector<float>> get_mel_filter_bank();
+  static std::vector<std::vector<float>> compute_stft(const std::vector<float>& audio, const FeaturePlan& plan);
+  static const FeaturePlan& default_plan();
 
   // Helper functions
   static float hz_to_mel(float hz);
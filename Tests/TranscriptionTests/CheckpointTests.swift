@@ -0,0 +1,134 @@
+//
+// CheckpointTests.swift
+// SwiftFasterWhisper Tests
+//
+// Created by Amr Aboelela on 10/18/2026.
+//
+
+import Testing
+import AVFoundation
+@testable import SwiftFasterWhisper
+
+@Suite(.serialized)
+struct CheckpointTests {
+
+    /// jfk.wav four times over (44s), so the transcription spans two seek windows
+    private func longAudio(_ base: TestBase) throws -> [Float] {
+        let audioPath = try base.findTestFile("jfk.wav")
+        let audioFrames = try base.convertAudioToPCM(audioPath: audioPath)
+        return Array([[Float]](repeating: audioFrames, count: 4).joined())
+    }
+
+    private func drain(_ transcription: ResumableTranscription) throws -> [TranscriptionSegment] {
+        var segments: [TranscriptionSegment] = []
+        while let segment = try transcription.next() {
+            segments.append(segment)
+        }
+        return segments
+    }
+
+    @Test func resumeMatchesUninterruptedRun() async throws {
+        let base = TestBase()
+        let whisper = try await base.getWhisper()
+        let audio = try longAudio(base)
+
+        print("\n========== CHECKPOINT RESUME TEST ==========")
+
+        let uninterrupted = try drain(whisper.startResumableTranscription(audio: audio, language: "en"))
+
+        // Interrupt after the first segment, when the first window is decoded and the second is not
+        let interrupted = try whisper.startResumableTranscription(audio: audio, language: "en")
+        let first = try #require(try interrupted.next())
+        let checkpoint = try interrupted.checkpoint()
+        #expect(interrupted.progress < Float(audio.count) / 16000, "The checkpoint should be taken mid-file")
+
+        let resumed = try drain(whisper.resumeTranscription(audio: audio, checkpoint: checkpoint))
+        let combined = [first] + resumed
+
+        print("Uninterrupted: \(uninterrupted.count) segments, resumed: 1 + \(resumed.count) segments, checkpoint: \(checkpoint.count) bytes")
+        print("============================================\n")
+
+        #expect(combined.map(\.text) == uninterrupted.map(\.text))
+        #expect(combined.map(\.start) == uninterrupted.map(\.start))
+        #expect(combined.map(\.end) == uninterrupted.map(\.end))
+    }
+
+    @Test func checkpointRejectsCorruptionAndOtherAudio() async throws {
+        let base = TestBase()
+        let whisper = try await base.getWhisper()
+        let audio = try longAudio(base)
+
+        let transcription = try whisper.startResumableTranscription(audio: audio, language: "en")
+        _ = try transcription.next()
+        let checkpoint = try transcription.checkpoint()
+
+        // Round trip: the untouched blob resumes
+        _ = try whisper.resumeTranscription(audio: audio, checkpoint: checkpoint)
+
+        // One flipped bit fails the CRC
+        var corrupted = checkpoint
+        corrupted[corrupted.count / 2] ^= 0x01
+        #expect(throws: RecognitionError.self) {
+            try whisper.resumeTranscription(audio: audio, checkpoint: corrupted)
+        }
+
+        // Truncated and empty blobs are rejected
+        #expect(throws: RecognitionError.self) {
+            try whisper.resumeTranscription(audio: audio, checkpoint: checkpoint.prefix(checkpoint.count - 9))
+        }
+        #expect(throws: RecognitionError.self) {
+            try whisper.resumeTranscription(audio: audio, checkpoint: Data())
+        }
+
+        // Different audio of the same length fails the audio digest
+        var otherAudio = audio
+        otherAudio[otherAudio.count / 2] += 0.01
+        #expect(throws: RecognitionError.self) {
+            try whisper.resumeTranscription(audio: otherAudio, checkpoint: checkpoint)
+        }
+    }
+
+    @Test func checkpointRejectsSeekOutsideTheAudio() async throws {
+        let base = TestBase()
+        let whisper = try await base.getWhisper()
+        let audio = try longAudio(base)
+
+        let transcription = try whisper.startResumableTranscription(audio: audio, language: "en")
+        _ = try transcription.next()
+        let checkpoint = try transcription.checkpoint()
+
+        // A seek past the last frame (or before the first) with a valid CRC is still refused
+        for seek in [Int32(audio.count / 160 + 100), Int32(-1)] {
+            let forged = withSeek(checkpoint, seek)
+            #expect(throws: RecognitionError.self) {
+                try whisper.resumeTranscription(audio: audio, checkpoint: forged)
+            }
+        }
+    }
+
+    /// Rewrite the seek field of a checkpoint blob and recompute its CRC-32 trailer
+    private func withSeek(_ checkpoint: Data, _ seek: Int32) -> Data {
+        var bytes = [UInt8](checkpoint)
+        func u32(_ offset: Int) -> Int {
+            (0..<4).reduce(0) { $0 | Int(bytes[offset + $1]) << (8 * $1) }
+        }
+        func put(_ value: UInt32, at offset: Int) {
+            for i in 0..<4 { bytes[offset + i] = UInt8(truncatingIfNeeded: value >> (8 * UInt32(i))) }
+        }
+
+        var offset = 8                      // magic, version
+        offset += 4 + u32(offset) + 4       // language, language_probability
+        offset += 4 + u32(offset) + 1       // task, multilingual
+        offset += 4 + 8 + 4                 // duration, content_frames, audio_crc
+        offset += 4 + 8 * u32(offset) + 8   // seek clips, clip_idx
+        put(UInt32(bitPattern: seek), at: offset)
+
+        var crc: UInt32 = 0xFFFF_FFFF
+        for byte in bytes.dropLast(4) {
+            crc ^= UInt32(byte)
+            for _ in 0..<8 { crc = (crc >> 1) ^ (0xEDB8_8320 & (0 &- (crc & 1))) }
+        }
+        put(~crc, at: bytes.count - 4)
+        return Data(bytes)
+    }
+}
@@ -0,0 +1,127 @@
+//
+// FeatureStreamTests.swift
+// SwiftFasterWhisper Tests
+//
+// Created by Amr Aboelela on 10/18/2026.
+//
+
+import Testing
+import AVFoundation
+@testable import SwiftFasterWhisper
+
+@Suite(.serialized)
+struct FeatureStreamTests {
+
+    /// 4.2s of jfk.wav: 421 frames, sent as 5 packets of up to 100 frames
+    private func window(_ base: TestBase, offset: Int = 0) throws -> [Float] {
+        let audioPath = try base.findTestFile("jfk.wav")
+        let audioFrames = try base.convertAudioToPCM(audioPath: audioPath)
+        return Array(audioFrames[offset..<(offset + 67_200)])
+    }
+
+    private func maxError(_ decoded: [[Float]], _ expected: [[Float]]) -> Float {
+        var error: Float = 0
+        for (decodedRow, expectedRow) in zip(decoded, expected) {
+            for (value, reference) in zip(decodedRow, expectedRow) {
+                error = max(error, abs(value - reference))
+            }
+        }
+        return error
+    }
+
+    @Test func roundTripFloat16() throws {
+        let base = TestBase()
+        let audio = try window(base)
+        let expected = FeatureStreamEncoder.melFeatures(of: audio)
+        let encoder = try #require(FeatureStreamEncoder(encoding: .float16))
+
+        let packets = encoder.encode(window: audio)
+        let decoded = try #require(FeatureStreamEncoder.decode(packets))
+        let error = maxError(decoded.features, expected)
+        print("FP16: \(packets.count) bytes for \(audio.count * 2) bytes of 16-bit PCM, max error \(error)")
+
+        #expect(decoded.features.count == expected.count)
+        #expect(decoded.features.first?.count == expected.first?.count)
+        #expect(decoded.droppedWindows == 0)
+        #expect(error < 0.002, "FP16 features should be within 0.002 of the device's. Got \(error)")
+    }
+
+    @Test func roundTripInt8() throws {
+        let base = TestBase()
+        let audio = try window(base)
+        let expected = FeatureStreamEncoder.melFeatures(of: audio)
+        let encoder = try #require(FeatureStreamEncoder(encoding: .int8))
+
+        let packets = encoder.encode(window: audio)
+        let decoded = try #require(FeatureStreamEncoder.decode(packets))
+        let error = maxError(decoded.features, expected)
+        print("INT8: \(packets.count) bytes for \(audio.count * 2) bytes of 16-bit PCM, max error \(error)")
+
+        #expect(decoded.features.count == expected.count)
+        #expect(decoded.features.first?.count == expected.first?.count)
+        // One quantization step of the log-mel range (about 2 units over 255 levels)
+        #expect(error < 0.01, "INT8 features should be within one quantization step. Got \(error)")
+        #expect(packets.count * 7 < audio.count * 2, "INT8 packets should be well under 1/7 of 16-bit PCM")
+    }
+
+    @Test func lostPacketDropsOnlyItsWindow() throws {
+        let base = TestBase()
+        let first = try window(base)
+        let second = try window(base, offset: 67_200)
+        let encoder = try #require(FeatureStreamEncoder(encoding: .int8))
+
+        var firstPackets = encoder.encode(window: first)
+        let secondPackets = encoder.encode(window: second)
+        // Lose the second packet of the first window (24-byte header, offset and scale, 100 x 80 values)
+        let packetSize = 24 + 8 + 100 * 80
+        firstPackets.removeSubrange(packetSize..<(2 * packetSize))
+
+        let decoded = try #require(FeatureStreamEncoder.decode(firstPackets + secondPackets))
+        let error = maxError(decoded.features, FeatureStreamEncoder.melFeatures(of: second))
+
+        #expect(decoded.droppedWindows == 1)
+        #expect(error < 0.01, "The window after the lost packet should decode intact. Got \(error)")
+    }
+
+    @Test func malformedPacketKeepsCompletedWindows() throws {
+        let base = TestBase()
+        let audio = try window(base)
+        let encoder = try #require(FeatureStreamEncoder(encoding: .int8))
+
+        let packets = encoder.encode(window: audio)
+        let decoded = try #require(FeatureStreamEncoder.decode(packets + Data(repeating: 0x5A, count: 40)))
+
+        #expect(decoded.features.count == 80)
+        #expect(FeatureStreamEncoder.decode(Data(repeating: 0x5A, count: 40)) == nil)
+    }
+
+    @Test func transcribeFeaturePackets() async throws {
+        let base = TestBase()
+        let whisper = try await base.getWhisper()
+
+        print("\n========== FEATURE STREAM TEST (English) ==========")
+
+        let audioPath = try base.findTestFile("jfk.wav")
+        let audioFrames = try base.convertAudioToPCM(audioPath: audioPath)
+        let encoder = try #require(FeatureStreamEncoder(encoding: .int8))
+        let session = try whisper.makeFeatureSession(language: "en")
+
+        // Device sends the whole clip as one window, as it would at a pause
+        let packets = encoder.encode(window: audioFrames)
+        let segments = session.push(packets)
+        let fullText = segments.map { $0.text }.joined(separator: " ")
+            .trimmingCharacters(in: .whitespacesAndNewlines).lowercased()
+
+        let expectedText = "and so my fellow americans ask not what your country can do for you ask what you can do for your country"
+        let comparison = base.compareWithReference(generated: fullText, expected: expectedText)
+
+        print("Packets: \(packets.count) bytes for \(audioFrames.count * 2) bytes of 16-bit PCM")
+        print("Generated: \(fullText)")
+        print("Accuracy: \(String(format: "%.2f", comparison.accuracy))%")
+        print("=======================================\n")
+
+        #expect(session.droppedWindows == 0)
+        #expect(comparison.accuracy > 80.0,
+            "Feature stream accuracy should be greater than 80%. Got \(String(format: "%.2f", comparison.accuracy))%")
+    }
+}
@@ -144,6 +144,303 @@ struct FileTranscriptionTests {
             "Turkish transcription accuracy should be greater than 60%. Got \(String(format: "%.2f", comparison.accuracy))%")
     }
 
+    @Test func transcribeStereoChannels() async throws {
+        let base = TestBase()
+        let whisper = try await base.getWhisper()
+
+        print("\n========== STEREO TRANSCRIPTION TEST (English) ==========")
+
+        let audioPath = try base.findTestFile("jfk.wav")
+        let audioFrames = try base.convertAudioToPCM(audioPath: audioPath)
+
+        // Same speech on both channels, shifted by one second on the right
+        let shift = 16000
+        let left = audioFrames + [Float](repeating: 0, count: shift)
+        let right = [Float](repeating: 0, count: shift) + audioFrames
+
+        let result = try await whisper.transcribeStereo(left: left, right: right, language: "en")
+        let leftText = result.left.text.trimmingCharacters(in: .whitespacesAndNewlines).lowercased()
+        let rightText = result.right.text.trimmingCharacters(in: .whitespacesAndNewlines).lowercased()
+
+        print("Left:  \(leftText)")
+        print("Right: \(rightText)")
+        print("==========================================")
+
+        let expectedText = "and so my fellow americans ask not what your country can do for you ask what you can do for your country"
+        let leftComparison = base.compareWithReference(generated: leftText, expected: expectedText)
+        let rightComparison = base.compareWithReference(generated: rightText, expected: expectedText)
+
+        #expect(leftComparison.accuracy > 80.0,
+            "Left channel accuracy should be greater than 80%. Got \(String(format: "%.2f", leftComparison.accuracy))%")
+        #expect(rightComparison.accuracy > 80.0,
+            "Right channel accuracy should be greater than 80%. Got \(String(format: "%.2f", rightComparison.accuracy))%")
+
+        // Timestamps share one timeline, so the right channel starts later
+        if let leftStart = result.left.segments.first?.start, let rightStart = result.right.segments.first?.start {
+            #expect(rightStart > leftStart, "Right channel should start after the left channel")
+        }
+    }
+
+    @Test func transcribeSegmentsLazily() async throws {
+        let base = TestBase()
+        let whisper = try await base.getWhisper()
+
+        print("\n========== LAZY TRANSCRIPTION TEST (English) ==========")
+
+        let audioPath = try base.findTestFile("jfk.wav")
+
+        var segments: [TranscriptionSegment] = []
+        for try await segment in try whisper.transcribeSegments(audioFilePath: audioPath, language: "en") {
+            print("[\(String(format: "%.2f", segment.start))s -> \(String(format: "%.2f", segment.end))s] \(segment.text)")
+            segments.append(segment)
+        }
+
+        let fullText = segments.map(\.text).joined().trimmingCharacters(in: .whitespacesAndNewlines).lowercased()
+        let expectedText = "and so my fellow americans ask not what your country can do for you ask what you can do for your country"
+        let comparison = base.compareWithReference(generated: fullText, expected: expectedText)
+
+        #expect(comparison.accuracy > 80.0,
+            "Lazy transcription accuracy should be greater than 80%. Got \(String(format: "%.2f", comparison.accuracy))%")
+
+        // A budget that is already spent stops before the first window
+        do {
+            for try await _ in try whisper.transcribeSegments(audioFilePath: audioPath, language: "en", timeBudget: 0.000001) {}
+            Issue.record("Should throw timeBudgetExceeded")
+        } catch RecognitionError.timeBudgetExceeded {
+            print("✅ Correctly threw timeBudgetExceeded")
+        }
+    }
+
+    @Test func transcribeProgressively() async throws {
+        let base = TestBase()
+        let whisper = try await base.getWhisper()
+
+        print("\n========== PROGRESSIVE TRANSCRIPTION TEST (English) ==========")
+
+        let audioPath = try base.findTestFile("jfk.wav")
+
+        var updates: [ProgressiveUpdate] = []
+        for try await update in try whisper.transcribeProgressive(audioFilePath: audioPath, language: "en") {
+            print("\(update.isFinal ? "final" : "draft") [\(update.start)s -> \(update.end)s] \(update.segments.map(\.text).joined())")
+            updates.append(update)
+        }
+
+        // Without a draft model the single replica decodes the whole draft first
+        let firstFinal = updates.firstIndex(where: \.isFinal) ?? updates.count
+        #expect(firstFinal > 0, "A draft update should come before the final pass")
+        #expect(updates[firstFinal...].allSatisfy(\.isFinal), "No draft update should follow the final pass")
+
+        // Draft updates never cover time the final pass has already reported
+        var finalEnd: Float = 0
+        for update in updates {
+            if update.isFinal {
+                finalEnd = max(finalEnd, update.end)
+            } else {
+                #expect(update.start >= finalEnd, "Draft update [\(update.start)s -> \(update.end)s] overlaps final text up to \(finalEnd)s")
+            }
+        }
+        #expect(updates.last?.isFinal == true, "The stream should end with the final pass")
+
+        let finalText = updates.filter(\.isFinal).flatMap(\.segments).map(\.text).joined()
+            .trimmingCharacters(in: .whitespacesAndNewlines).lowercased()
+        let expectedText = "and so my fellow americans ask not what your country can do for you ask what you can do for your country"
+        let comparison = base.compareWithReference(generated: finalText, expected: expectedText)
+
+        #expect(comparison.accuracy > 80.0,
+            "Final pass accuracy should be greater than 80%. Got \(String(format: "%.2f", comparison.accuracy))%")
+    }
+
+    @Test func alignKnownText() async throws {
+        let base = TestBase()
+        let whisper = try await base.getWhisper()
+
+        print("\n========== FORCED ALIGNMENT TEST (English) ==========")
+
+        let audioPath = try base.findTestFile("jfk.wav")
+        let audioFrames = try base.convertAudioToPCM(audioPath: audioPath)
+        let duration = Float(audioFrames.count) / 16000
+
+        let texts = [
+            "And so my fellow Americans, ask not what your country can do for you,",
+            "ask what you can do for your country."
+        ]
+        let segments = try await whisper.align(audio: audioFrames, texts: texts, language: "en")
+
+        for segment in segments {
+            print("[\(String(format: "%.2f", segment.start))s -> \(String(format: "%.2f", segment.end))s] \(segment.text)")
+            for word in segment.words {
+                print("    [\(String(format: "%.2f", word.start))s -> \(String(format: "%.2f", word.end))s]\(word.word)")
+            }
+        }
+
+        #expect(segments.count == texts.count, "Should return one aligned segment per text")
+        // Punctuation may come back as separate words
+        #expect(segments.count == 2 && segments[0].words.count >= 14 && segments[1].words.count >= 8,
+            "Every word should be aligned")
+
+        let words = segments.flatMap(\.words)
+        #expect(zip(words, words.dropFirst()).allSatisfy { $0.start <= $1.start }, "Words should be in order")
+        #expect(words.allSatisfy { $0.start >= 0 && $0.end <= duration + 0.01 }, "Words should fall inside the audio")
+        if segments.count == 2 {
+            #expect(segments[1].start >= segments[0].end - 0.01, "Second text should start after the first")
+        }
+    }
+
+    @Test func transcribeWithEncoderEmbeddings() async throws {
+        let base = TestBase()
+        let whisper = try await base.getWhisper()
+
+        print("\n========== ENCODER EMBEDDINGS TEST (English) ==========")
+
+        let audioPath = try base.findTestFile("jfk.wav")
+        let audioFrames = try base.convertAudioToPCM(audioPath: audioPath)
+
+        let (result, embeddings) = try await whisper.transcribeWithEmbeddings(audio: audioFrames, language: "en")
+        for embedding in embeddings {
+            print("[\(embedding.start)s -> \(embedding.end)s] \(embedding.positions) x \(embedding.dimension)")
+        }
+
+        #expect(!result.text.isEmpty, "Transcription should still be returned")
+        #expect(embeddings.count == 1, "An 11 second file is encoded in one window")
+        if let embedding = embeddings.first {
+            #expect(embedding.positions == 1 && embedding.values.count == embedding.dimension, "Pooled embedding is one vector")
+            #expect(embedding.dimension > 0 && embedding.values.allSatisfy(\.isFinite), "Embedding values should be finite")
+        }
+    }
+
+    @Test func transcribeWithTimeCompression() async throws {
+        let base = TestBase()
+        let whisper = try await base.getWhisper()
+
+        print("\n========== TIME COMPRESSION TEST (English) ==========")
+
+        let audioPath = try base.findTestFile("jfk.wav")
+        let audioFrames = try base.convertAudioToPCM(audioPath: audioPath)
+        let expectedText = "and so my fellow americans ask not what your country can do for you ask what you can do for your country"
+
+        defer { try? whisper.setTimeCompression(1.0) }
+        for factor: Float in [1.0, 1.25, 1.5] {
+            try whisper.setTimeCompression(factor)
+            let startTime = Date()
+            let result = try await whisper.transcribe(audio: audioFrames, language: "en")
+            let elapsed = Date().timeIntervalSince(startTime)
+            let comparison = base.compareWithReference(generated: result.text.lowercased(), expected: expectedText)
+
+            print("Factor \(factor): \(String(format: "%.2f", elapsed))s, accuracy \(String(format: "%.2f", comparison.accuracy))%")
+            print("  Generated: \(result.text)")
+
+            #expect(comparison.accuracy > 80.0,
+                "Accuracy at \(factor)x should be greater than 80%. Got \(String(format: "%.2f", comparison.accuracy))%")
+            #expect(abs(result.duration - Float(audioFrames.count) / 16000) < 0.1, "Duration should be the original duration")
+            if let last = result.segments.last {
+                #expect(last.end > result.duration * 0.8 && last.end <= result.duration + 0.1,
+                    "Timestamps should be mapped back to the original time")
+            }
+        }
+        print("=======================================\n")
+
+        #expect(throws: RecognitionError.self) {
+            try whisper.setTimeCompression(3.0)
+        }
+    }
+
+    @Test func tokenBudgetLeavesNormalSpeechUnchanged() async throws {
+        let base = TestBase()
+        let whisper = try await base.getWhisper()
+
+        let audioPath = try base.findTestFile("jfk.wav")
+        let audioFrames = try base.convertAudioToPCM(audioPath: audioPath)
+
+        // Off by default; a 20 tokens/s budget stays well above real speech
+        let unbudgeted = try await whisper.transcribe(audio: audioFrames, language: "en")
+        try whisper.setTokenBudget(tokensPerSecond: 20)
+        defer { try? whisper.setTokenBudget(tokensPerSecond: 0) }
+        let budgeted = try await whisper.transcribe(audio: audioFrames, language: "en")
+
+        #expect(budgeted.text == unbudgeted.text, "A budget above the speech rate should not change the transcript")
+        #expect(budgeted.segments.map(\.end) == unbudgeted.segments.map(\.end))
+
+        #expect(throws: RecognitionError.self) {
+            try whisper.setTokenBudget(tokensPerSecond: -1)
+        }
+    }
+
+    @Test func tokenBudgetCutsOffWindowEarly() async throws {
+        let base = TestBase()
+        let whisper = try await base.getWhisper()
+
+        // jfk.wav twice (22s): one window holding about 65 tokens
+        let audioPath = try base.findTestFile("jfk.wav")
+        let audioFrames = try base.convertAudioToPCM(audioPath: audioPath)
+        let audio = Array([[Float]](repeating: audioFrames, count: 2).joined())
+        let duration = Float(audio.count) / 16000
+
+        // Without a budget the first window is decoded to its end
+        let full = try whisper.startResumableTranscription(audio: audio, language: "en")
+        _ = try full.next()
+        #expect(full.progress > duration * 0.9, "The whole window should be decoded in one pass, got \(full.progress)s")
+
+        // A 0.25 tokens/s budget (38 tokens for this window) stands in for a repetition loop:
+        // every attempt is cut off, so the window stops after its last complete segment
+        try whisper.setTokenBudget(tokensPerSecond: 0.25)
+        defer { try? whisper.setTokenBudget(tokensPerSecond: 0) }
+        let capped = try whisper.startResumableTranscription(audio: audio, language: "en")
+        _ = try capped.next()
+        print("Progress after the first window: \(full.progress)s without a budget, \(capped.progress)s with one")
+        #expect(capped.progress < duration * 0.75, "The capped window should stop early, got \(capped.progress)s")
+    }
+
+    @Test func decodeFlacMatchesWav() throws {
+        let base = TestBase()
+
+        // jfk.flac is jfk.wav encoded losslessly, so every sample must match
+        let wavSamples = try SwiftFasterWhisper.loadAudio(path: base.findTestFile("jfk.wav"))
+        let flacSamples = try SwiftFasterWhisper.loadAudio(path: base.findTestFile("jfk.flac"))
+
+        #expect(flacSamples.count == wavSamples.count)
+        let maxDifference = zip(flacSamples, wavSamples).map { abs($0 - $1) }.max() ?? 0
+        #expect(maxDifference == 0, "FLAC samples should equal the WAV samples. Max difference \(maxDifference)")
+    }
+
+    @Test func downmixMultichannelWav() throws {
+        let base = TestBase()
+        let mono = try SwiftFasterWhisper.loadAudio(path: base.findTestFile("jfk.wav"))
+
+        // Three channels: the speech twice and a silent one, so the mix is 2/3 of the speech
+        let pcm = mono.map { Int16(max(-32768, min(32767, ($0 * 32768).rounded()))) }
+        var data = Data()
+        func append<T: FixedWidthInteger>(_ value: T) {
+            withUnsafeBytes(of: value.littleEndian) { data.append(contentsOf: $0) }
+        }
+        let channels: UInt16 = 3
+        let dataSize = UInt32(pcm.count * Int(channels) * 2)
+        data.append(contentsOf: Array("RIFF".utf8))
+        append(UInt32(36) + dataSize)
+        data.append(contentsOf: Array("WAVEfmt ".utf8))
+        append(UInt32(16))
+        append(UInt16(1))
+        append(channels)
+        append(UInt32(16000))
+        append(UInt32(16000 * 2 * UInt32(channels)))
+        append(UInt16(2 * channels))
+        append(UInt16(16))
+        data.append(contentsOf: Array("data".utf8))
+        append(dataSize)
+        for sample in pcm {
+            append(sample)
+            append(sample)
+            append(Int16(0))
+        }
+        let path = FileManager.default.temporaryDirectory.appendingPathComponent("jfk_3ch.wav").path
+        try data.write(to: URL(fileURLWithPath: path))
+        defer { try? FileManager.default.removeItem(atPath: path) }
+
+        let mixed = try SwiftFasterWhisper.loadAudio(path: path)
+        #expect(mixed.count == mono.count)
+        let maxDifference = zip(mixed, mono).map { abs($0 - $1 * 2 / 3) }.max() ?? 0
+        #expect(maxDifference < 1e-4, "Channels should be averaged. Max difference \(maxDifference)")
+    }
+
     @Test func emptyAudioError() async throws {
         let base = TestBase()
         let whisper = try await base.getWhisper()
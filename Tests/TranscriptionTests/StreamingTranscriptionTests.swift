@@ -145,6 +145,154 @@ struct StreamingTranscriptionTests {
             "Turkish streaming accuracy should be greater than 35%. Got \(String(format: "%.2f", comparison.accuracy))%")
     }
 
+    @Test func streamWithCustomWindowGeometry() async throws {
+        let base = TestBase()
+        let modelPath = try await base.downloadModelIfNeeded()
+
+        print("\n========== STREAMING TEST (3s windows, auto-sized) ==========")
+
+        let audioPath = try base.findTestFile("jfk.wav")
+        let fullAudio = try base.convertAudioToPCM(audioPath: audioPath)
+
+        // A window longer than the model's 30s input is rejected
+        let rejected = ModelManager(modelPath: modelPath)
+        try await rejected.loadModel()
+        await rejected.configure(language: "en", streaming: StreamingConfiguration(windowDuration: 40, maxWindowDuration: 40))
+        await #expect(throws: RecognitionError.self) {
+            try await rejected.startStreaming()
+        }
+        await rejected.shutdown()
+
+        let recognizer = StreamingRecognizer(modelPath: modelPath)
+        let streaming = StreamingConfiguration(windowDuration: 3.0, hopDuration: 2.8, autoSize: true)
+        try await recognizer.configure(language: "en", streaming: streaming)
+
+        var allText = ""
+        let producer = ChunksProducer(audio: fullAudio)
+        try await producer.start(
+            onChunk: { _, chunk, _ in
+                let text = await recognizer.addAudioChunk(chunk)
+                if !text.isEmpty {
+                    allText += allText.isEmpty ? text : " " + text
+                }
+            },
+            onComplete: {
+                let finalText = await recognizer.addAudioChunk([])
+                if !finalText.isEmpty {
+                    allText += allText.isEmpty ? finalText : " " + finalText
+                }
+                await recognizer.stop()
+            }
+        )
+
+        let expectedText = "and so my fellow americans ask not what your country can do for you ask what you can do for your country"
+        let comparison = base.compareWithReference(generated: allText.lowercased(), expected: expectedText)
+        print("Generated: \(allText)")
+        print("Accuracy: \(String(format: "%.2f", comparison.accuracy))%")
+
+        #expect(comparison.accuracy > 60.0,
+            "Short-window streaming accuracy should be greater than 60%. Got \(String(format: "%.2f", comparison.accuracy))%")
+    }
+
+    @Test func catchUpWindowCoversBacklogAndShrinksBack() async throws {
+        let base = TestBase()
+        let modelPath = try await base.downloadModelIfNeeded()
+
+        print("\n========== STREAMING CATCH-UP TEST ==========")
+
+        let audioPath = try base.findTestFile("jfk.wav")
+        let fullAudio = try base.convertAudioToPCM(audioPath: audioPath)
+
+        let manager = ModelManager(modelPath: modelPath)
+        try await manager.loadModel()
+        await manager.configure(language: "en")
+        try await manager.startStreaming()
+        let window = await manager.streamingWindowDuration()
+
+        // 44s arrive at once, far more than one window plus a hop (4.2s + 4.0s)
+        try await manager.addChunk(Array([[Float]](repeating: fullAudio, count: 4).joined()))
+
+        var windows: [Double] = []
+        var texts: [String] = []
+        while windows.count < 10 {
+            let next = await manager.nextStreamingWindowDuration()
+            guard next > window + 0.01 else { break }
+            windows.append(next)
+            texts += try await manager.getNewSegments().map(\.text)
+        }
+        print("Catch-up windows: \(windows.map { String(format: "%.1f", $0) }.joined(separator: ", "))s")
+        print("Generated: \(texts.joined(separator: " "))")
+
+        // The backlog is decoded in windows capped at 30s instead of 4.2s at a time
+        #expect(windows.count >= 1 && windows.count <= 2, "The 44s backlog should take one or two catch-up windows")
+        #expect(abs((windows.first ?? 0) - 30.0) < 0.01, "The first catch-up window should be capped at 30s")
+        #expect(windows.allSatisfy { $0 <= 30.0 + 0.01 }, "No window may exceed the model's 30s input")
+        #expect(!texts.isEmpty, "The catch-up windows should produce text")
+
+        // Once caught up, the window shrinks back to its configured size
+        try await manager.addChunk([Float](repeating: 0, count: 16000 * 5))
+        let caughtUp = await manager.nextStreamingWindowDuration()
+        #expect(abs(caughtUp - window) < 0.01, "The window should shrink back to \(window)s, got \(caughtUp)s")
+
+        await manager.shutdown()
+    }
+
+    @Test func migrateStreamingSessionBetweenWorkers() async throws {
+        let base = TestBase()
+        let modelPath = try await base.downloadModelIfNeeded()
+
+        print("\n========== STREAMING MIGRATION TEST ==========")
+
+        let audioPath = try base.findTestFile("jfk.wav")
+        let fullAudio = try base.convertAudioToPCM(audioPath: audioPath)
+        let chunkSize = 16000
+        let chunks = stride(from: 0, to: fullAudio.count, by: chunkSize).map {
+            Array(fullAudio[$0..<min($0 + chunkSize, fullAudio.count)])
+        }
+
+        // Two workers with the same model; the stream moves halfway through the audio
+        let first = ModelManager(modelPath: modelPath)
+        let second = ModelManager(modelPath: modelPath)
+        try await first.loadModel()
+        try await second.loadModel()
+        await first.configure(language: "en")
+        try await first.startStreaming()
+
+        var texts: [String] = []
+        for chunk in chunks[..<(chunks.count / 2)] {
+            try await first.addChunk(chunk)
+            texts += try await first.getNewSegments().map(\.text)
+        }
+
+        let snapshot = try await first.streamingSnapshot()
+        print("Snapshot: \(snapshot.count) bytes")
+        await first.shutdown()
+
+        try await second.restoreStreaming(from: snapshot)
+        for chunk in chunks[(chunks.count / 2)...] {
+            try await second.addChunk(chunk)
+            texts += try await second.getNewSegments().map(\.text)
+        }
+        // Flush the last partial window with silence
+        try await second.addChunk([Float](repeating: 0, count: 16000 * 5))
+        texts += try await second.getNewSegments().map(\.text)
+
+        // A corrupt snapshot is rejected without touching the running session
+        await #expect(throws: RecognitionError.self) {
+            try await second.restoreStreaming(from: Data("not a snapshot".utf8))
+        }
+        await second.shutdown()
+
+        let allText = texts.joined(separator: " ")
+        let expectedText = "and so my fellow americans ask not what your country can do for you ask what you can do for your country"
+        let comparison = base.compareWithReference(generated: allText.lowercased(), expected: expectedText)
+        print("Generated: \(allText)")
+        print("Accuracy: \(String(format: "%.2f", comparison.accuracy))%")
+
+        #expect(comparison.accuracy > 60.0,
+            "Migrated streaming accuracy should be greater than 60%. Got \(String(format: "%.2f", comparison.accuracy))%")
+    }
+
     @Test func streamReturnsEmptyWhenNoTextReady() async throws {
         let base = TestBase()
         let modelPath = try await base.downloadModelIfNeeded()